@@ -0,0 +1,11 @@
+// Generates SIZE module masses, one per line, in the range of the real input.
+#include "common/generate.hpp"
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      out << random.between<uint64_t>(50000, 150000) << '\n';
+    }
+  });
+}
@@ -1,31 +1,179 @@
+#include "common/input.hpp"
+#include "common/runner.hpp"
+#include "common/simd.hpp"
+#include "common/tasks.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <numeric>
+#include <span>
+#include <utility>
 #include <vector>
 
+namespace {
+
+// fuel for a module's mass alone
+constexpr uint64_t fuel(uint64_t mass) { return (mass / 3) - 2; }
+
+// fuel for a module's mass, plus fuel for that fuel, and so on
+constexpr uint64_t total_fuel(uint64_t mass) {
+  uint64_t total = 0;
+  while (mass >= 9) {
+    mass = (mass / 3) - 2;
+    total += mass;
+  }
+  return total;
+}
+
 auto part_1(const std::vector<uint64_t> &modules) {
   return std::transform_reduce(modules.cbegin(), modules.cend(), 0ul,
-                               std::plus<uint64_t>{},
-                               [](auto mass) { return (mass / 3) - 2; });
+                               std::plus<uint64_t>{}, fuel);
 }
 
 auto part_2(const std::vector<uint64_t> &modules) {
   return std::transform_reduce(modules.cbegin(), modules.cend(), 0ul,
-                               std::plus<uint64_t>{}, [](auto mass) {
-                                 uint64_t total_fuel = 0;
-                                 while (mass >= 9) {
-                                   mass = (mass / 3) - 2;
-                                   total_fuel += mass;
-                                 }
-                                 return total_fuel;
-                               });
+                               std::plus<uint64_t>{}, total_fuel);
 }
 
-int main() {
+// `total_fuel()` of every mass below this, so that the fuel chain of a
+// module stops as soon as it gets there: 3-4 steps for typical masses.
+// 16 KB, which stays in L1.
+constexpr uint32_t fuel_tail_size = 1 << 12;
+constexpr auto fuel_tails = [] {
+  std::array<uint32_t, fuel_tail_size> tails{};
+  for (uint32_t mass = 0; mass < fuel_tail_size; ++mass) {
+    tails[mass] = total_fuel(mass);
+  }
+  return tails;
+}();
+
+constexpr size_t lanes = 8;
+using aoc::u32x8;
+using aoc::u64x8;
+
+struct Fuel {
+  uint64_t part_1 = 0;
+  uint64_t part_2 = 0;
+};
+
+// Both parts in one pass, 8 modules at a time: every lane follows its fuel
+// chain down to the tail table, and lanes that get there early just idle
+// until the others do. As fuel grows with mass, the heaviest module of a
+// block tells how many steps that takes, with no need to look at the lanes.
+// Blocks with a mass that doesn't fit in 32 bits fall back to the scalar
+// functions.
+// Time: O(n)
+Fuel fuel_simd(std::span<const uint64_t> masses) {
+  // mass / 3 as a multiply and a shift, exact for every 32-bit mass
+  const auto div3 = [](const u32x8 &mass) {
+    const auto wide = __builtin_convertvector(mass, u64x8);
+    return __builtin_convertvector((wide * 0xAAAAAAABul) >> 33, u32x8);
+  };
+  u64x8 part_1{}, part_2{};
+  uint64_t scalar_part_1 = 0, scalar_part_2 = 0;
+  size_t simd_modules = 0;
+  size_t i = 0;
+  for (; i + lanes <= masses.size(); i += lanes) {
+    u64x8 wide;
+    std::memcpy(&wide, &masses[i], sizeof(wide));
+    uint64_t heaviest = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      heaviest = std::max(heaviest, wide[lane]);
+    }
+    if (heaviest > UINT32_MAX) {
+      for (size_t j = i; j < i + lanes; ++j) {
+        scalar_part_1 += fuel(masses[j]);
+        scalar_part_2 += total_fuel(masses[j]);
+      }
+      continue;
+    }
+    auto mass = __builtin_convertvector(wide, u32x8);
+    // part 1's "- 2" is subtracted once at the end
+    part_1 += __builtin_convertvector(div3(mass), u64x8);
+    simd_modules += lanes;
+    // a chain is at most half its mass, so 32 bits suffice
+    u32x8 tail{};
+    for (; heaviest >= fuel_tail_size; heaviest = fuel(heaviest)) {
+      const auto active = (u32x8)(mass >= fuel_tail_size);
+      const auto next = div3(mass) - 2;
+      mass = (next & active) | (mass & ~active);
+      tail += next & active;
+    }
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      tail[lane] += fuel_tails[mass[lane]];
+    }
+    part_2 += __builtin_convertvector(tail, u64x8);
+  }
+  for (; i < masses.size(); ++i) {
+    scalar_part_1 += fuel(masses[i]);
+    scalar_part_2 += total_fuel(masses[i]);
+  }
+  Fuel result{scalar_part_1 - 2 * simd_modules, scalar_part_2};
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    result.part_1 += part_1[lane];
+    result.part_2 += part_2[lane];
+  }
+  return result;
+}
+
+// `fuel_simd()` over chunks of the modules on every hardware thread.
+Fuel fuel_parallel(const std::vector<uint64_t> &modules) {
+  constexpr size_t min_chunk = 1 << 16;
+  const auto chunks =
+      aoc::map_chunks(modules.size(), min_chunk, [&](size_t begin, size_t end) {
+        return fuel_simd(std::span(modules).subspan(begin, end - begin));
+      });
+  aoc::count("chunks", chunks.size());
+  Fuel total;
+  for (const auto &chunk : chunks) {
+    total.part_1 += chunk.part_1;
+    total.part_2 += chunk.part_2;
+  }
+  return total;
+}
+
+// Both parts in one pass over the module masses, without storing them.
+auto stream_parts(aoc::LineReader &lines) {
+  uint64_t part_1_fuel = 0, part_2_fuel = 0;
+  for (const auto line : lines) {
+    for (aoc::Scanner scanner{line}; !scanner.done();) {
+      const auto mass = scanner.number<uint64_t>();
+      part_1_fuel += fuel(mass);
+      part_2_fuel += total_fuel(mass);
+    }
+  }
+  return std::pair{part_1_fuel, part_2_fuel};
+}
+
+auto parse(std::string_view text) {
   std::vector<uint64_t> modules;
-  for (uint64_t mass; std::cin >> mass;) {
-    modules.push_back(mass);
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    modules.push_back(scanner.number<uint64_t>());
+  }
+  return modules;
+}
+
+int run_day(aoc::Runner &runner) {
+  if (runner.streaming()) {
+    runner.stream("stream", stream_parts);
+    return runner.finish();
   }
-  std::cout << "Part 1: " << part_1(modules) << std::endl;
-  std::cout << "Part 2: " << part_2(modules) << std::endl;
-  return 0;
+  const auto &modules = runner.parse(parse);
+  aoc::count("modules", modules.size());
+  // one pass computes both parts, which then just read them
+  const auto &totals =
+      runner.derive("fuel_parallel", [&] { return fuel_parallel(modules); });
+  runner.part(1, "part_1", [&] { return part_1(modules); });
+  runner.part(2, "part_2", [&] { return part_2(modules); });
+  runner.part(1, "part_1_simd", [&] { return totals.part_1; });
+  runner.part(2, "part_2_simd", [&] { return totals.part_2; });
+  runner.stream("stream", stream_parts);
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2019, 1, run_day)
@@ -0,0 +1,12 @@
+// Generates SIZE dial moves, one per line, e.g. "L68" or "R1234".
+#include "common/generate.hpp"
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      out << (random.chance(0.5) ? 'L' : 'R') << random.between(1, 999)
+          << '\n';
+    }
+  });
+}
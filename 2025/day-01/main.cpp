@@ -1,10 +1,23 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include "common/tasks.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
-constexpr int SIZE = 100;
+namespace {
+
+// the puzzle's dial; `DialSummary` works with any size and start
+constexpr int SIZE = 100, START = 50;
 
 int part_1(const std::vector<std::pair<char, int>> &moves) {
-  int zero_count = 0, pos = 50;
+  int zero_count = 0, pos = START;
   for (const auto &[dir, steps] : moves) {
     if (dir == 'L') {
       pos = (pos - steps + SIZE) % SIZE;
@@ -19,7 +32,7 @@ int part_1(const std::vector<std::pair<char, int>> &moves) {
 }
 
 int part_2_simple(const std::vector<std::pair<char, int>> &moves) {
-  int zero_count = 0, pos = 50;
+  int zero_count = 0, pos = START;
   for (const auto &[dir, steps] : moves) {
     for (int i = 0; i < steps; ++i) {
       if (dir == 'L') {
@@ -36,7 +49,7 @@ int part_2_simple(const std::vector<std::pair<char, int>> &moves) {
 }
 
 int part_2_optimized(const std::vector<std::pair<char, int>> &moves) {
-  int zero_count = 0, pos = 50;
+  int zero_count = 0, pos = START;
   for (const auto &[dir, steps] : moves) {
     const auto full_cycles = steps / SIZE, remaining_steps = steps % SIZE;
     zero_count += full_cycles;
@@ -56,23 +69,141 @@ int part_2_optimized(const std::vector<std::pair<char, int>> &moves) {
   return zero_count;
 }
 
-int main() {
-  std::vector<std::pair<char, int>> moves;
-  char dir;
-  int steps;
-  while (std::cin >> dir >> steps) {
-    moves.emplace_back(dir, steps);
+// What a run of moves does to a dial of `size` positions, for every position
+// it may start at: it turns the dial by `offset` in total, and from start
+// position p it stops at 0 `stops[p]` times (part 1) and passes 0 `passes[p]`
+// times (part 2). So one summary answers both parts for every start position
+// at once. Summaries of consecutive runs compose, so that long runs can be
+// split into chunks summarized in parallel.
+struct DialSummary {
+  int size;
+  int offset = 0;
+  std::vector<uint64_t> stops, passes;
+
+  explicit DialSummary(int size = SIZE)
+      : size(size), stops(size), passes(size) {}
+
+  // Time: O(moves + size)
+  static DialSummary of(std::span<const std::pair<char, int>> moves,
+                        int size = SIZE) {
+    // the puzzle's dial gets divisions by a constant
+    return size == SIZE ? of<SIZE>(moves) : of<0>(moves, size);
+  }
+
+  // `of()` for a dial of `FixedSize` positions, or of `size` if it's 0.
+  template <int FixedSize>
+  static DialSummary of(std::span<const std::pair<char, int>> moves,
+                        int runtime_size = 0) {
+    const int size = FixedSize ? FixedSize : runtime_size;
+    DialSummary summary(size);
+    // Passing 0 depends on the start position p only through which interval
+    // of positions (mod size) a move's last partial turn sweeps, so every
+    // move just adds 1 to a cyclic range of p, kept as a difference array.
+    std::vector<int64_t> pass_diff(size + 1);
+    // `first` is within (-size, size)
+    const auto add_range = [&](int first, int length) {
+      first += (first < 0) * size;
+      ++pass_diff[first];
+      if (first + length <= size) {
+        --pass_diff[first + length];
+      } else {
+        --pass_diff[size];
+        ++pass_diff[0];
+        --pass_diff[first + length - size];
+      }
+    };
+    uint64_t full_cycles = 0;
+    int pos = 0; // where start position 0 is now
+    for (const auto &[dir, steps] : moves) {
+      full_cycles += steps / size;
+      const auto remaining_steps = steps % size;
+      if (dir == 'L') {
+        // p passes 0 iff 0 < p + pos <= remaining_steps (mod size)
+        if (remaining_steps > 0) {
+          add_range(1 - pos, remaining_steps);
+        }
+        pos -= remaining_steps;
+        pos += (pos < 0) * size;
+      } else {
+        // p passes 0 iff p + pos >= size - remaining_steps (mod size)
+        if (remaining_steps > 0) {
+          add_range(size - remaining_steps - pos, remaining_steps);
+        }
+        pos += remaining_steps;
+        pos -= (pos >= size) * size;
+      }
+      // p stops at 0 iff p + pos = 0 (mod size)
+      ++summary.stops[pos == 0 ? 0 : size - pos];
+    }
+    summary.offset = pos;
+    int64_t passes = 0;
+    for (int p = 0; p < size; ++p) {
+      passes += pass_diff[p];
+      summary.passes[p] = full_cycles + passes;
+    }
+    return summary;
+  }
+
+  // This run followed by `next`, on the same dial.
+  // Time: O(size)
+  DialSummary then(const DialSummary &next) const {
+    DialSummary combined(size);
+    combined.offset = (offset + next.offset) % size;
+    for (int p = 0; p < size; ++p) {
+      const auto mid = (p + offset) % size;
+      combined.stops[p] = stops[p] + next.stops[mid];
+      combined.passes[p] = passes[p] + next.passes[mid];
+    }
+    return combined;
+  }
+};
+
+// Summarize chunks of the moves on every hardware thread, then combine the
+// chunk summaries in order. There are only as many as threads, so that scan
+// is cheap next to summarizing.
+// Time: O(moves / threads + threads * size)
+DialSummary summarize_parallel(const std::vector<std::pair<char, int>> &moves,
+                               int size = SIZE) {
+  constexpr size_t min_chunk = 1 << 14;
+  const auto chunks =
+      aoc::map_chunks(moves.size(), min_chunk, [&](size_t begin, size_t end) {
+        return DialSummary::of(std::span(moves).subspan(begin, end - begin),
+                               size);
+      });
+  aoc::count("chunks", chunks.size());
+  auto total = chunks.front();
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    total = total.then(chunks[i]);
   }
-  std::cout << "Number of moves: " << moves.size() << std::endl;
-  std::cout << "Part 1: " << part_1(moves) << std::endl;
-  const auto part_2_simple_ = part_2_simple(moves),
-             part_2_optimized_ = part_2_optimized(moves);
-  if (part_2_simple_ != part_2_optimized_) {
-    std::cerr << "Part 2 implementations do not match: simple="
-              << part_2_simple_ << ", optimized=" << part_2_optimized_
-              << std::endl;
-    return 1;
+  return total;
+}
+
+auto parse(std::string_view text) {
+  std::vector<std::pair<char, int>> moves;
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    const auto dir = scanner.next();
+    if (dir != 'L' && dir != 'R') {
+      throw std::runtime_error("Invalid direction: " + std::string(1, dir));
+    }
+    moves.emplace_back(dir, scanner.number<int>());
   }
-  std::cout << "Part 2: " << part_2_simple_ << std::endl;
-  return 0;
+  return moves;
+}
+
+int run_day(aoc::Runner &runner) {
+  const auto &moves = runner.parse(parse);
+  aoc::count("moves", moves.size());
+  // one summary of all moves answers both parts, from any start position
+  const auto &summary = runner.derive(
+      "summary_parallel", [&] { return summarize_parallel(moves); });
+  runner.part(1, "part_1", [&] { return part_1(moves); });
+  runner.part(1, "part_1_parallel", [&] { return summary.stops[START]; });
+  runner.part(2, "part_2_simple", [&] { return part_2_simple(moves); });
+  runner.part(2, "part_2_optimized", [&] { return part_2_optimized(moves); });
+  runner.part(2, "part_2_parallel", [&] { return summary.passes[START]; });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 1, run_day)
@@ -0,0 +1,27 @@
+// Generates SIZE comma-separated ranges "from-to" on a single line. Widths
+// are log-uniform between 1 and 10^6, so ranges may overlap, and numbers have
+// up to 10 digits.
+#include "common/generate.hpp"
+#include <algorithm>
+#include <cmath>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr uint64_t max_number = 9'999'999'999;
+    constexpr uint64_t max_width = 1'000'000;
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      // pick the number of digits first, so that short numbers show up too
+      const auto digits = random.between(1, 10);
+      const auto lo = static_cast<uint64_t>(std::pow(10, digits - 1));
+      const auto hi = std::min(lo * 10 - 1, max_number);
+      const auto from = random.between(lo, hi);
+      const auto width = static_cast<uint64_t>(
+          std::pow(10, random.between(0, 6000) / 1000.0));
+      const auto to =
+          std::min({from + width - 1, from + max_width, max_number});
+      out << (i == 0 ? "" : ",") << from << '-' << to;
+    }
+    out << '\n';
+  });
+}
@@ -1,10 +1,29 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include "common/tasks.hpp"
+#include "common/wide.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+namespace {
+
 constexpr auto number_delimiter = '-', range_delimiter = ',';
-// we only expect up to 10 digits, as we hardcode the dividers below
-constexpr auto expected_max_number{9'999'999'999};
+
+using aoc::uint128;
+using Range = std::pair<uint128, uint128>;
+
+// part 2 allows any number of repetitions
+constexpr auto any_repeat_count = std::numeric_limits<int>::max();
 
 // If we break down an invalid (repetitive) number like "987987987", it's "987"
 // repeated three times, equivalent to 987 + 987 * 1000 + 987 * 1000000 = 987 *
@@ -16,26 +35,52 @@ constexpr auto expected_max_number{9'999'999'999};
 // 1          -> 2 ... 10      -> 11, 111, ..., 11111111111
 // 2          -> 2 ... 5       -> 101, 10101, ..., 101010101
 // 3          -> 2 ... 3       -> 1001, 1001001
-// 4          -> 2             -> 10001
-// 5          -> 2             -> 100001
-
-const std::vector<std::vector<int>> dividers = {
-    {11, 111, 1111, 11111, 111111, 1111111, 11111111, 111111111, 1111111111},
-    {101, 10101, 1010101, 101010101},
-    {1001, 1001001},
-    {10001},
-    {100001}};
-
-bool is_repetitive(long long num, int repeat_count_max) {
-  for (auto i = 0, min = 1; i < static_cast<int>(dividers.size());
-       ++i, min *= 10) {
-    for (auto j = 0;
-         j < static_cast<int>(dividers[i].size()) && j + 2 <= repeat_count_max;
-         ++j) {
-      const auto divider = dividers[i][j];
+// ...
+//
+// It's generated at compile time for every number of `Number`, i.e. up to 19
+// digits for uint64_t and 38 for uint128, so that numbers that fit in 64 bits
+// don't pay for 128-bit divisions.
+template <typename Number> struct Repetitions {
+  // the most digits every number of them can have
+  static constexpr int max_digits = [] {
+    int digits = 0;
+    for (Number power = 1; power <= Number(~Number{0}) / 10; power *= 10) {
+      ++digits;
+    }
+    return digits;
+  }();
+
+  static constexpr auto pow10 = [] {
+    std::array<Number, max_digits + 1> powers{};
+    powers[0] = 1;
+    for (int i = 1; i <= max_digits; ++i) {
+      powers[i] = powers[i - 1] * 10;
+    }
+    return powers;
+  }();
+
+  // dividers[substr len][repeat count], 0 where that's more than max_digits
+  static constexpr auto dividers = [] {
+    std::array<std::array<Number, max_digits + 1>, max_digits / 2 + 1> table{};
+    for (int len = 1; len <= max_digits / 2; ++len) {
+      for (int count = 2; len * count <= max_digits; ++count) {
+        table[len][count] = (pow10[len * count] - 1) / (pow10[len] - 1);
+      }
+    }
+    return table;
+  }();
+};
+
+template <typename Number>
+bool is_repetitive(Number num, int repeat_count_max) {
+  using R = Repetitions<Number>;
+  for (auto len = 1; len <= R::max_digits / 2; ++len) {
+    for (auto count = 2;
+         len * count <= R::max_digits && count <= repeat_count_max; ++count) {
+      const auto divider = R::dividers[len][count];
       // check if num = x * divider, where x is a substring of the exact length
-      if (num % divider == 0 && (num / divider) >= min &&
-          (num / divider) < min * 10) {
+      if (num % divider == 0 && (num / divider) >= R::pow10[len - 1] &&
+          (num / divider) < R::pow10[len]) {
         return true;
       }
     }
@@ -43,12 +88,18 @@ bool is_repetitive(long long num, int repeat_count_max) {
   return false;
 }
 
-long long solve(const std::vector<std::pair<long long, long long>> &ranges,
-                int repeat_count_max) {
-  long long result = 0;
-  for (const auto [from, to] : ranges) {
+// Time: O(total width of the ranges)
+uint128 solve(const std::vector<Range> &ranges, int repeat_count_max) {
+  uint128 result = 0;
+  for (const auto &[from, to] : ranges) {
+    // up to 19 digits take the 64-bit path
+    const bool narrow = to < Repetitions<uint64_t>::pow10.back();
     for (auto num = from; num <= to; ++num) {
-      if (is_repetitive(num, repeat_count_max)) {
+      const bool repetitive =
+          narrow
+              ? is_repetitive(static_cast<uint64_t>(num), repeat_count_max)
+              : is_repetitive(num, repeat_count_max);
+      if (repetitive) {
         result += num;
       }
     }
@@ -56,33 +107,244 @@ long long solve(const std::vector<std::pair<long long, long long>> &ranges,
   return result;
 }
 
-int main() {
-  std::vector<std::pair<long long, long long>> ranges;
+[[noreturn]] void fail_too_large() {
+  throw std::runtime_error("The sum of the repetitive numbers doesn't fit in "
+                           "128 bits");
+}
+
+uint128 checked_add(uint128 a, uint128 b) {
+  uint128 sum;
+  if (__builtin_add_overflow(a, b, &sum)) {
+    fail_too_large();
+  }
+  return sum;
+}
+
+// The sum of the numbers in [from, to] that are a block of `block` digits
+// repeated to `digits` digits, i.e. x * divider for every x of exactly
+// `block` digits that keeps the product within the range.
+// Time: O(1)
+template <typename Number>
+uint128 sum_repeated_blocks(Number from, Number to, int digits, int block) {
+  using R = Repetitions<Number>;
+  const auto divider = R::dividers[block][digits / block];
+  const auto lo = std::max(R::pow10[block - 1], (from + divider - 1) / divider);
+  const auto hi = std::min(R::pow10[block] - 1, to / divider);
+  if (lo > hi) {
+    return 0;
+  }
+  // x has at most 19 digits, so this fits
+  const auto x_sum = (uint128{lo} + hi) * (hi - lo + 1) / 2;
+  uint128 sum;
+  if (__builtin_mul_overflow(x_sum, uint128{divider}, &sum)) {
+    fail_too_large();
+  }
+  return sum;
+}
+
+// The sum of the repetitive numbers in [from, to] with exactly `digits`
+// digits.
+//
+// A number is a block repeated k times iff it is one of the x * divider of
+// the (digits / k)-digit block, so we add those up for every allowed k. A
+// number that repeats blocks of several sizes (1111 = "11" * 2 = "1" * 4)
+// would be counted several times, so we use inclusion-exclusion: being a
+// repetition of blocks of digits / a and of digits / b means being one of
+// blocks of digits / lcm(a, b).
+// Time: O(2^(number of allowed repeat counts)), at most 8 terms
+template <typename Number>
+uint128 sum_repetitive(Number from, Number to, int digits,
+                       int repeat_count_max) {
+  // the allowed repeat counts that aren't multiples of another one, as those
+  // are covered by it already; no more than 3 for up to 38 digits
+  std::array<int, 4> repeat_counts{};
+  size_t n = 0;
+  for (int k = 2; k <= std::min(digits, repeat_count_max); ++k) {
+    if (digits % k == 0 &&
+        std::none_of(repeat_counts.cbegin(), repeat_counts.cbegin() + n,
+                     [&](int other) { return k % other == 0; })) {
+      repeat_counts[n++] = k;
+    }
+  }
+  // the terms of odd subsets can only add up to more than the result, so
+  // it fits if they do
+  uint128 added = 0, subtracted = 0;
+  for (unsigned subset = 1; subset < (1u << n); ++subset) {
+    int repeat_lcm = 1;
+    for (size_t i = 0; i < n; ++i) {
+      if (subset & (1u << i)) {
+        repeat_lcm = std::lcm(repeat_lcm, repeat_counts[i]);
+      }
+    }
+    const auto sum = sum_repeated_blocks(from, to, digits, digits / repeat_lcm);
+    if (std::popcount(subset) % 2 == 0) {
+      subtracted += sum;
+    } else {
+      added = checked_add(added, sum);
+    }
+  }
+  return added - subtracted;
+}
+
+// The part of a range with a given number of digits.
+struct Segment {
+  uint128 from, to;
+  int digits;
+};
+
+// Cut the ranges where the number of digits changes, as that's what
+// `sum_repetitive()` works on.
+std::vector<Segment> split_by_digits(const std::vector<Range> &ranges) {
+  using Wide = Repetitions<uint128>;
+  std::vector<Segment> segments;
+  for (const auto &[from, to] : ranges) {
+    for (int digits = 2; digits <= Wide::max_digits; ++digits) {
+      const auto lo = std::max(from, Wide::pow10[digits - 1]);
+      const auto hi = std::min(to, Wide::pow10[digits] - 1);
+      if (lo <= hi) {
+        segments.push_back({lo, hi, digits});
+      }
+    }
+  }
+  return segments;
+}
+
+// `sum_repetitive()` of a segment, on the 64-bit path for up to 19 digits.
+uint128 sum_segment(const Segment &segment, int repeat_count_max) {
+  using Narrow = Repetitions<uint64_t>;
+  static_assert(Narrow::max_digits == 19);
+  if (segment.digits <= Narrow::max_digits) {
+    return sum_repetitive(static_cast<uint64_t>(segment.from),
+                          static_cast<uint64_t>(segment.to), segment.digits,
+                          repeat_count_max);
+  }
+  return sum_repetitive(segment.from, segment.to, segment.digits,
+                        repeat_count_max);
+}
+
+// Generate the repetitive numbers of every range instead of testing every
+// number in it, one digit count at a time.
+// Time: O(ranges * digits), independent of how wide the ranges are
+uint128 solve_enumerate(const std::vector<Range> &ranges,
+                        int repeat_count_max) {
+  uint128 result = 0;
+  for (const auto &segment : split_by_digits(ranges)) {
+    result = checked_add(result, sum_segment(segment, repeat_count_max));
+  }
+  return result;
+}
+
+struct Sums {
+  uint128 part_1 = 0;
+  uint128 part_2 = 0;
+  bool too_large = false;
+};
+
+// Both parts in one pass over the segments, in chunks on every hardware
+// thread. Summing a segment takes the same few steps however wide it is, so
+// chunks of as many segments cost about the same.
+// Time: O(ranges * digits / threads)
+Sums solve_parallel(const std::vector<Range> &ranges) {
+  const auto segments = split_by_digits(ranges);
+  constexpr size_t min_chunk = 1 << 8;
+  const auto chunks = aoc::map_chunks(
+      segments.size(), min_chunk, [&](size_t begin, size_t end) {
+        Sums sums;
+        // `map_chunks()` wants no exceptions, so we report them afterwards
+        try {
+          for (size_t i = begin; i < end; ++i) {
+            sums.part_1 = checked_add(sums.part_1, sum_segment(segments[i], 2));
+            sums.part_2 = checked_add(
+                sums.part_2, sum_segment(segments[i], any_repeat_count));
+          }
+        } catch (const std::runtime_error &) {
+          sums.too_large = true;
+        }
+        return sums;
+      });
+  aoc::count("chunks", chunks.size());
+  Sums total;
+  for (const auto &chunk : chunks) {
+    if (chunk.too_large) {
+      fail_too_large();
+    }
+    total.part_1 = checked_add(total.part_1, chunk.part_1);
+    total.part_2 = checked_add(total.part_2, chunk.part_2);
+  }
+  return total;
+}
+
+// Sort the ranges and merge the ones that overlap or touch, so that no
+// number is counted twice.
+// Time: O(n log n)
+std::vector<Range> normalize(std::vector<Range> ranges) {
+  std::erase_if(ranges, [](const Range &range) {
+    return range.first > range.second;
+  });
+  std::sort(ranges.begin(), ranges.end());
+  std::vector<Range> merged;
+  for (const auto &[from, to] : ranges) {
+    if (!merged.empty() &&
+        (from <= merged.back().second || from - merged.back().second == 1)) {
+      merged.back().second = std::max(merged.back().second, to);
+    } else {
+      merged.emplace_back(from, to);
+    }
+  }
+  return merged;
+}
+
+auto parse(std::string_view text) {
+  std::vector<Range> ranges;
   // input format: from-to,from2-to2
-  char delimiter;
-  long long max_number = 0;
-  for (long long from, to; std::cin >> from >> delimiter >> to;) {
-    if (delimiter != number_delimiter) {
-      std::cerr << "Unexpected number delimiter: " << delimiter << std::endl;
-      return 1;
+  for (const auto range : aoc::split(text, range_delimiter)) {
+    aoc::Scanner scanner{range};
+    if (scanner.done()) {
+      continue; // e.g. the trailing newline
+    }
+    const auto from = aoc::to_uint128(scanner.word());
+    if (!scanner.consume(number_delimiter)) {
+      throw std::runtime_error(std::string("Unexpected number delimiter: ") +
+                               scanner.peek());
     }
+    const auto to = aoc::to_uint128(scanner.word());
     ranges.emplace_back(from, to);
-    max_number = std::max(max_number, to);
-    // consume the trailing range delimiter
-    if (std::cin >> delimiter && delimiter != range_delimiter) {
-      std::cerr << "Unexpected range delimiter: " << delimiter << std::endl;
-      return 1;
+    // anything left must have been separated by a wrong range delimiter
+    if (!scanner.done()) {
+      throw std::runtime_error(std::string("Unexpected range delimiter: ") +
+                               scanner.peek());
     }
   }
-  if (max_number > expected_max_number) {
-    std::cerr << "Can't handle this input. The max number in it is too large. "
-                 "max_number="
-              << max_number << ", which can't be larger than "
-              << expected_max_number << std::endl;
-    return 1;
-  }
-  std::cout << "Part 1: " << solve(ranges, 2) << std::endl;
-  std::cout << "Part 2: " << solve(ranges, std::numeric_limits<int>::max())
-            << std::endl;
-  return 0;
+  return normalize(std::move(ranges));
 }
+
+int run_day(aoc::Runner &runner) {
+  const auto &ranges = runner.parse(parse);
+  aoc::count("ranges", ranges.size());
+  // one pass over all ranges computes both parts
+  const auto &sums =
+      runner.derive("solve_parallel", [&] { return solve_parallel(ranges); });
+  // `solve()` tests every number, so it only checks the others on ranges
+  // narrow enough for that to be quick
+  constexpr uint128 solve_max_width = 10'000'000;
+  uint128 total_width = 0;
+  for (const auto &[from, to] : ranges) {
+    total_width += to - from + 1;
+  }
+  if (total_width <= solve_max_width) {
+    runner.part(1, "solve", [&] { return solve(ranges, 2); });
+  }
+  runner.part(1, "solve_enumerate", [&] { return solve_enumerate(ranges, 2); });
+  if (total_width <= solve_max_width) {
+    runner.part(2, "solve", [&] { return solve(ranges, any_repeat_count); });
+  }
+  runner.part(2, "solve_enumerate",
+              [&] { return solve_enumerate(ranges, any_repeat_count); });
+  runner.part(1, "solve_parallel", [&] { return sums.part_1; });
+  runner.part(2, "solve_parallel", [&] { return sums.part_2; });
+  return runner.finish();
+}
+
+} // namespace
+
+AOC_MAIN(2025, 2, run_day)
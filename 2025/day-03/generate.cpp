@@ -0,0 +1,15 @@
+// Generates SIZE battery banks of 100 digits (1-9) each, one per line.
+#include "common/generate.hpp"
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr int bank_size = 100;
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      for (int j = 0; j < bank_size; ++j) {
+        out << static_cast<char>('0' + random.between(1, 9));
+      }
+      out << '\n';
+    }
+  });
+}
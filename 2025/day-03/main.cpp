@@ -1,33 +1,61 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include "common/simd.hpp"
+#include "common/tasks.hpp"
+#include "common/wide.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-int part_1(const std::vector<std::string> &banks) {
+namespace {
+
+constexpr int part_2_digits = 12;
+// the most that fit in a long long
+constexpr int max_digits = 18;
+static_assert(part_2_digits <= max_digits);
+
+// Largest joltage from 2 batteries of a bank that has at least 2
+int pair_joltage(std::string_view bank) {
+  char max = 0, sub_max = bank.back();
+  for (auto b : bank | std::views::reverse | std::views::drop(1)) {
+    if (b >= max) {
+      sub_max = std::max(sub_max, max);
+      max = b;
+    }
+  }
+  return (max - '0') * 10 + (sub_max - '0');
+}
+
+int part_1(const std::vector<std::string_view> &banks) {
   int total_joltage = 0;
   for (const auto &bank : banks) {
-    if (banks.size() < 2) {
+    if (bank.size() < 2) {
       std::cerr
           << "Invalid input: the battery bank has fewer than 2 batteries: "
           << bank << std::endl;
       return -1;
     }
-    char max = 0, sub_max = bank.back();
-    for (auto b : bank | std::views::reverse | std::views::drop(1)) {
-      if (b >= max) {
-        sub_max = std::max(sub_max, max);
-        max = b;
-      }
-    }
-    const auto joltage = ((max - '0') * 10 + (sub_max - '0'));
-    total_joltage += joltage;
+    total_joltage += pair_joltage(bank);
   }
   return total_joltage;
 }
 
 // Naive solution, just do multiple `max_element`s per battery bank
 // Time: O(N * digits) per bank
-long long part_2_naive(const std::vector<std::string> &banks,
+long long part_2_naive(const std::vector<std::string_view> &banks,
                        const int digits) {
   long long total_joltage = 0;
   for (const auto &bank : banks) {
@@ -51,9 +79,38 @@ long long part_2_naive(const std::vector<std::string> &banks,
   return total_joltage;
 }
 
+// Largest joltage from `digits` (up to `max_digits`) batteries of a bank that
+// has at least that many, using a monotonic stack. It never needs to hold more
+// than `digits` batteries, so it lives on the stack.
+// Time: O(N)
+long long bank_joltage(std::string_view bank, const int digits) {
+  if (digits > max_digits) {
+    throw std::runtime_error("Can't select more than " +
+                             std::to_string(max_digits) + " batteries");
+  }
+  std::array<char, max_digits> mono_stack;
+  int size = 0;
+  const int n = bank.size();
+  for (int i = 0; i < n; ++i) {
+    const auto b = bank[i];
+    // pop smaller batteries while the rest of the bank can still refill it
+    while (size > 0 && mono_stack[size - 1] < b && size + (n - i) > digits) {
+      --size;
+    }
+    if (size < digits) {
+      mono_stack[size++] = b;
+    }
+  }
+  long long joltage = 0;
+  for (int i = 0; i < digits; ++i) {
+    joltage = joltage * 10 + (mono_stack[i] - '0');
+  }
+  return joltage;
+}
+
 // Optimized solution using a monotonic stack
 // Time: O(N) per bank
-long long part_2_optimized(const std::vector<std::string> &banks,
+long long part_2_optimized(const std::vector<std::string_view> &banks,
                            const int digits) {
   long long total_joltage = 0;
   for (const auto &bank : banks) {
@@ -63,34 +120,406 @@ long long part_2_optimized(const std::vector<std::string> &banks,
           << bank << std::endl;
       return -1;
     }
+    total_joltage += bank_joltage(bank, digits);
+  }
+  return total_joltage;
+}
 
-    std::deque<char> mono_stack;
-    int removals = bank.size() - digits;
-    for (const auto b : bank) {
-      while (!mono_stack.empty() && removals > 0 && mono_stack.back() < b) {
-        mono_stack.pop_back();
-        --removals;
-      }
-      mono_stack.push_back(b);
+// 32 byte lanes, one AVX2 register
+constexpr size_t lanes = 32;
+using aoc::u64x4;
+using aoc::u8x32;
+
+u8x32 load(const char *p) {
+  u8x32 block;
+  std::memcpy(&block, p, lanes);
+  return block;
+}
+
+// the index of the first set lane of a comparison's result, or `lanes`
+size_t first_set(const u8x32 &mask) {
+  const auto words = (u64x4)mask;
+  for (size_t i = 0; i < lanes / 8; ++i) {
+    if (words[i]) {
+      return i * 8 + std::countr_zero(words[i]) / 8;
     }
-    // only keep the top `digits` elements
-    long long joltage = 0;
-    for (int i = 0; i < digits; ++i) {
-      joltage = joltage * 10 + (mono_stack[i] - '0');
+  }
+  return lanes;
+}
+
+// the first `byte` in [lo, hi), 32 at a time, or `hi`
+const char *find_byte(const char *lo, const char *hi, uint8_t byte) {
+  for (; lo + lanes <= hi; lo += lanes) {
+    if (const auto lane = first_set(load(lo) == byte); lane < lanes) {
+      return lo + lane;
     }
-    total_joltage += joltage;
+  }
+  return std::find(lo, hi, static_cast<char>(byte));
+}
+
+// the largest byte in [lo, hi), 32 at a time
+uint8_t max_byte(const char *lo, const char *hi) {
+  u8x32 max_lanes{};
+  for (; lo + lanes <= hi; lo += lanes) {
+    const auto block = load(lo);
+    max_lanes = block > max_lanes ? block : max_lanes;
+  }
+  uint8_t max = 0;
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    max = std::max(max, max_lanes[lane]);
+  }
+  for (; lo < hi; ++lo) {
+    max = std::max(max, static_cast<uint8_t>(*lo));
+  }
+  return max;
+}
+
+// The first largest battery in the non-empty [lo, hi). Nothing beats a '9',
+// and windows mostly have one in their first block, so we look for that
+// before looking for the largest one.
+// Time: O(hi - lo)
+const char *max_battery(const char *lo, const char *hi) {
+  if (const auto nine = find_byte(lo, hi, '9'); nine != hi) {
+    return nine;
+  }
+  return find_byte(lo, hi, max_byte(lo, hi));
+}
+
+// Largest joltage from `digits` batteries of a bank that has at least that
+// many, like `part_2_naive()` but with `max_battery()`.
+// Time: O(N * digits)
+uint64_t simd_joltage(std::string_view bank, const int digits) {
+  uint64_t joltage = 0;
+  const char *lo = bank.data();
+  for (int i = 0; i < digits; ++i) {
+    const auto hi = bank.data() + bank.size() - digits + i + 1;
+    const auto battery = max_battery(lo, hi);
+    joltage = joltage * 10 + (*battery - '0');
+    lo = battery + 1;
+  }
+  return joltage;
+}
+
+long long part_2_simd(const std::vector<std::string_view> &banks,
+                      const int digits) {
+  long long total_joltage = 0;
+  for (const auto &bank : banks) {
+    if (static_cast<int>(bank.size()) < digits) {
+      std::cerr
+          << "Invalid input! The battery bank doesn't have enough batteries: "
+          << bank << std::endl;
+      return -1;
+    }
+    total_joltage += simd_joltage(bank, digits);
   }
   return total_joltage;
 }
 
-int main() {
-  std::vector<std::string> banks;
-  for (std::string bank; std::cin >> bank;) {
-    banks.emplace_back(bank);
+struct Joltage {
+  uint64_t part_1 = 0;
+  uint64_t part_2 = 0;
+};
+
+// Both parts from one selection of `part_2_digits` batteries, like
+// `simd_joltage()`. Part 1's first battery is the largest but the last one:
+// part 2's first pick, unless one of the `tail` batteries between that pick's
+// window and the last beats it. Its second is the largest after the first,
+// which for part 2's first pick is part 2's second pick or one of the last
+// `tail` batteries. So part 1 only looks at the last batteries again, which
+// part 2 has just read.
+Joltage simd_joltages(std::string_view bank) {
+  constexpr int tail = part_2_digits - 2;
+  Joltage joltage;
+  const char *lo = bank.data();
+  const char *end = bank.data() + bank.size();
+  std::array<const char *, 2> picks;
+  for (int i = 0; i < part_2_digits; ++i) {
+    const auto battery = max_battery(lo, end - part_2_digits + i + 1);
+    if (i < 2) {
+      picks[i] = battery;
+    }
+    joltage.part_2 = joltage.part_2 * 10 + (*battery - '0');
+    lo = battery + 1;
+  }
+  char first, second;
+  if (const auto tail_max = std::max_element(end - tail - 1, end - 1);
+      *tail_max > *picks[0]) {
+    first = *tail_max;
+    second = *std::max_element(tail_max + 1, end);
+  } else {
+    first = *picks[0];
+    second = std::max(*picks[1], *std::max_element(end - tail, end));
   }
-  std::cout << "Number of battery banks: " << banks.size() << std::endl;
-  std::cout << "Part 1: " << part_1(banks) << std::endl;
-  std::cout << "Part 2: " << part_2_naive(banks, 12) << std::endl;
-  std::cout << "Part 2: " << part_2_optimized(banks, 12) << std::endl;
-  return 0;
+  joltage.part_1 = (first - '0') * 10 + (second - '0');
+  return joltage;
 }
+
+// Both parts in one pass over the banks, in chunks on every hardware thread,
+// with one selection per bank.
+// Time: O(N * digits / threads)
+Joltage joltage_parallel(const std::vector<std::string_view> &banks) {
+  for (const auto &bank : banks) {
+    if (static_cast<int>(bank.size()) < part_2_digits) {
+      throw std::runtime_error(
+          "Invalid input! The battery bank doesn't have enough batteries: " +
+          std::string(bank));
+    }
+  }
+  constexpr size_t min_chunk = 1 << 12;
+  const auto chunks =
+      aoc::map_chunks(banks.size(), min_chunk, [&](size_t begin, size_t end) {
+        Joltage joltage;
+        for (size_t i = begin; i < end; ++i) {
+          const auto bank = simd_joltages(banks[i]);
+          joltage.part_1 += bank.part_1;
+          joltage.part_2 += bank.part_2;
+        }
+        return joltage;
+      });
+  aoc::count("chunks", chunks.size());
+  Joltage total;
+  for (const auto &chunk : chunks) {
+    total.part_1 += chunk.part_1;
+    total.part_2 += chunk.part_2;
+  }
+  return total;
+}
+
+// Where each digit next occurs from any position of a bank, so that the
+// largest joltage of any number of batteries takes O(1) per battery. Each
+// digit has a bitmap of its positions, and for each 64-bit word of that the
+// next word with any set, which is about 2 bytes per battery in all.
+class BankIndex {
+private:
+  static constexpr size_t word_bits = 64;
+
+  size_t size_;
+  size_t words;
+  // [digit][word]
+  std::vector<uint64_t> bits;
+  // [digit][word], the first word from there on with any bits, or `words`
+  std::vector<uint32_t> next_word;
+
+public:
+  // `bank` has only digits
+  explicit BankIndex(std::string_view bank)
+      : size_(bank.size()), words((bank.size() + word_bits - 1) / word_bits),
+        bits(10 * words), next_word(10 * (words + 1)) {
+    for (size_t i = 0; i < size_; ++i) {
+      bits[(bank[i] - '0') * words + i / word_bits] |= uint64_t{1}
+                                                       << (i % word_bits);
+    }
+    for (int digit = 0; digit < 10; ++digit) {
+      auto *next = &next_word[digit * (words + 1)];
+      next[words] = words;
+      for (size_t w = words; w-- > 0;) {
+        next[w] = bits[digit * words + w] ? w : next[w + 1];
+      }
+    }
+  }
+
+  size_t size() const { return size_; }
+
+  // the first position from `pos` on that has `digit`, or `size()`
+  // Time: O(1)
+  size_t next(int digit, size_t pos) const {
+    size_t w = pos / word_bits;
+    if (w >= words) {
+      return size_;
+    }
+    auto word = bits[digit * words + w] & (~uint64_t{0} << (pos % word_bits));
+    if (!word) {
+      w = next_word[digit * (words + 1) + w + 1];
+      if (w == words) {
+        return size_;
+      }
+      word = bits[digit * words + w];
+    }
+    return w * word_bits + std::countr_zero(word);
+  }
+
+  // Call `f` with each digit of the largest joltage from `k` batteries, for
+  // `k <= size()`: the greedy choice of `part_2_naive()`, with the first of
+  // the largest digits in each window found by trying 9 down to 0.
+  // Time: O(k)
+  template <typename F> void joltage(size_t k, F &&f) const {
+    size_t lo = 0;
+    for (size_t i = 0; i < k; ++i) {
+      const auto hi = size_ - k + i; // the last battery we may take
+      for (int digit = 9; digit >= 0; --digit) {
+        if (const auto pos = next(digit, lo); pos <= hi) {
+          f(digit);
+          lo = pos + 1;
+          break;
+        }
+      }
+    }
+  }
+};
+
+std::vector<BankIndex> index_banks(const std::vector<std::string_view> &banks) {
+  for (const auto &bank : banks) {
+    if (std::any_of(bank.cbegin(), bank.cend(),
+                    [](char b) { return b < '0' || b > '9'; })) {
+      throw std::runtime_error(
+          "Invalid input! The battery bank has a battery that isn't a digit: " +
+          std::string(bank));
+    }
+  }
+  constexpr size_t min_chunk = 1 << 12;
+  auto chunks =
+      aoc::map_chunks(banks.size(), min_chunk, [&](size_t begin, size_t end) {
+        std::vector<BankIndex> indexes;
+        indexes.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+          indexes.emplace_back(banks[i]);
+        }
+        return indexes;
+      });
+  std::vector<BankIndex> indexes;
+  indexes.reserve(banks.size());
+  for (auto &chunk : chunks) {
+    std::move(chunk.begin(), chunk.end(), std::back_inserter(indexes));
+  }
+  return indexes;
+}
+
+// `sum += addend`, for non-negative decimal numbers of any length
+void add_decimal(std::string &sum, std::string_view addend) {
+  if (sum.size() < addend.size()) {
+    sum.insert(0, addend.size() - sum.size(), '0');
+  }
+  int carry = 0;
+  auto s = sum.rbegin();
+  for (auto a = addend.rbegin(); a != addend.rend() || carry; ++s) {
+    if (s == sum.rend()) {
+      sum.insert(sum.begin(), '0');
+      s = sum.rend() - 1;
+    }
+    const int digit =
+        (*s - '0') + (a != addend.rend() ? *a++ - '0' : 0) + carry;
+    *s = '0' + digit % 10;
+    carry = digit / 10;
+  }
+}
+
+// The total largest joltage of all banks for each of `ks`, as exact decimal
+// numbers however many digits that is. Chunks of banks are queried on every
+// hardware thread, each bank for all of `ks` at once.
+// Time: O(banks * sum(ks) / threads)
+std::vector<std::string> total_joltages(const std::vector<BankIndex> &indexes,
+                                        std::span<const size_t> ks) {
+  if (ks.empty()) {
+    return {};
+  }
+  for (const auto &index : indexes) {
+    if (index.size() < *std::max_element(ks.begin(), ks.end())) {
+      throw std::runtime_error("Invalid input! A battery bank doesn't have "
+                               "enough batteries");
+    }
+  }
+  // up to 18 digits, a bank's joltage fits in 64 bits and any total of them
+  // in 128; beyond that we add decimal digits
+  constexpr size_t max_wide_digits = 18;
+  constexpr size_t min_chunk = 1 << 10;
+  const auto chunks = aoc::map_chunks(
+      indexes.size(), min_chunk, [&](size_t begin, size_t end) {
+        std::vector<std::string> totals(ks.size(), "0");
+        std::vector<aoc::uint128> wide_totals(ks.size());
+        std::string digits;
+        for (size_t i = begin; i < end; ++i) {
+          for (size_t q = 0; q < ks.size(); ++q) {
+            if (ks[q] <= max_wide_digits) {
+              uint64_t joltage = 0;
+              indexes[i].joltage(ks[q],
+                                 [&](int d) { joltage = joltage * 10 + d; });
+              wide_totals[q] += joltage;
+            } else {
+              digits.clear();
+              indexes[i].joltage(ks[q], [&](int d) { digits += '0' + d; });
+              add_decimal(totals[q], digits);
+            }
+          }
+        }
+        for (size_t q = 0; q < ks.size(); ++q) {
+          add_decimal(totals[q], aoc::to_string(wide_totals[q]));
+        }
+        return totals;
+      });
+  auto totals = chunks.front();
+  for (size_t c = 1; c < chunks.size(); ++c) {
+    for (size_t q = 0; q < ks.size(); ++q) {
+      add_decimal(totals[q], chunks[c][q]);
+    }
+  }
+  // the decimal totals start with the zeros of the banks' leading ones
+  for (auto &total : totals) {
+    total.erase(0, std::min(total.find_first_not_of('0'), total.size() - 1));
+  }
+  return totals;
+}
+
+// Both parts in one pass over the banks, without storing them.
+auto stream_parts(aoc::LineReader &lines) {
+  // unsigned, so that totals of huge generated inputs wrap around harmlessly
+  uint64_t part_1_joltage = 0, part_2_joltage = 0, banks = 0;
+  for (const auto line : lines) {
+    for (aoc::Scanner scanner{line}; !scanner.done(); ++banks) {
+      const auto bank = scanner.token();
+      if (static_cast<int>(bank.size()) < part_2_digits) {
+        throw std::runtime_error(
+            "Invalid input! The battery bank doesn't have enough batteries: " +
+            std::string(bank));
+      }
+      part_1_joltage += pair_joltage(bank);
+      part_2_joltage += bank_joltage(bank, part_2_digits);
+    }
+  }
+  aoc::count("battery_banks", banks);
+  return std::pair{part_1_joltage, part_2_joltage};
+}
+
+auto parse(std::string_view text) {
+  // the banks point into the input buffer, no copies
+  std::vector<std::string_view> banks;
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    banks.emplace_back(scanner.token());
+  }
+  return banks;
+}
+
+int run_day(aoc::Runner &runner) {
+  if (runner.streaming()) {
+    runner.stream("stream", stream_parts);
+    return runner.finish();
+  }
+  const auto &banks = runner.parse(parse);
+  aoc::count("battery_banks", banks.size());
+  // one pass over the banks computes both parts
+  const auto &joltage = runner.derive(
+      "joltage_parallel", [&] { return joltage_parallel(banks); });
+  // answers any number of batteries, here both parts at once
+  const auto &indexes =
+      runner.derive("index_banks", [&] { return index_banks(banks); });
+  const auto &index_totals = runner.derive("total_joltages", [&] {
+    constexpr std::array<size_t, 2> ks{2, part_2_digits};
+    return total_joltages(indexes, ks);
+  });
+  runner.part(1, "part_1", [&] { return part_1(banks); });
+  runner.part(1, "part_1_parallel", [&] { return joltage.part_1; });
+  runner.part(2, "part_2_naive",
+              [&] { return part_2_naive(banks, part_2_digits); });
+  runner.part(2, "part_2_optimized",
+              [&] { return part_2_optimized(banks, part_2_digits); });
+  runner.part(2, "part_2_simd",
+              [&] { return part_2_simd(banks, part_2_digits); });
+  runner.part(2, "part_2_parallel", [&] { return joltage.part_2; });
+  runner.part(1, "part_1_index", [&] { return index_totals[0]; });
+  runner.part(2, "part_2_index", [&] { return index_totals[1]; });
+  runner.stream("stream", stream_parts);
+  return runner.finish();
+}
+
+} // namespace
+
+AOC_MAIN(2025, 3, run_day)
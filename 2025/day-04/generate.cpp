@@ -0,0 +1,16 @@
+// Generates a SIZE x SIZE grid of paper rolls ('@') and empty cells ('.'),
+// with roughly the density of the real inputs.
+#include "common/generate.hpp"
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr double roll_density = 0.65;
+    aoc::Random random{args.seed};
+    for (uint64_t r = 0; r < args.size; ++r) {
+      for (uint64_t c = 0; c < args.size; ++c) {
+        out << (random.chance(roll_density) ? '@' : '.');
+      }
+      out << '\n';
+    }
+  });
+}
@@ -1,26 +1,42 @@
+#include "common/arena.hpp"
+#include "common/grid.hpp"
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include "common/simd.hpp"
+#include "common/tasks.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
-int part_1(const std::vector<std::vector<bool>> &grid) {
-  const int rows = grid.size(), cols = grid[0].size();
+namespace {
+
+// The grid is padded, so the neighbours of edge cells need no bounds checks.
+int part_1(const aoc::BitGrid &grid) {
+  const int rows = grid.rows(), cols = grid.cols();
   int total = 0;
-  const auto access = [&](int r, int c) -> bool {
-    if (r < 0 || r >= rows || c < 0 || c >= cols) {
-      return false;
-    }
-    return grid[r][c];
-  };
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
-      if (!access(r, c)) {
+      if (!grid(r, c)) {
         continue;
       }
       int count = 0;
       for (int dr = -1; dr <= 1; ++dr) {
         for (int dc = -1; dc <= 1; ++dc) {
-          count += access(r + dr, c + dc);
+          count += grid(r + dr, c + dc);
         }
       }
       total += (count <= 4);
@@ -29,19 +45,117 @@ int part_1(const std::vector<std::vector<bool>> &grid) {
   return total;
 }
 
+// 4 words at a time
+constexpr size_t lanes = 4;
+using aoc::u64x4;
+
+// The rolls of a word of a row that have fewer than 4 neighbouring rolls, for
+// `Word`s of a row and of the rows above and below it, each given as {the
+// word before, the word, the word after}. A cell's west neighbour is the bit
+// below it, so the words before and after shift in across word boundaries.
+// The 8 neighbour masks are added with bit-sliced full adders, keeping only
+// whether the count reaches 4.
+template <typename Word>
+Word accessible(const std::array<Word, 3> &above,
+                const std::array<Word, 3> &row,
+                const std::array<Word, 3> &below) {
+  const auto west = [](const auto &w) { return (w[1] << 1) | (w[0] >> 63); };
+  const auto east = [](const auto &w) { return (w[1] >> 1) | (w[2] << 63); };
+  const auto full_add = [](const Word &a, const Word &b, const Word &c,
+                           Word &carry) {
+    carry = (a & b) | (c & (a ^ b));
+    return a ^ b ^ c;
+  };
+  Word above_carry, below_carry, ones_carry, twos_carry;
+  const auto above_sum =
+      full_add(west(above), above[1], east(above), above_carry);
+  const auto below_sum =
+      full_add(west(below), below[1], east(below), below_carry);
+  const auto row_west = west(row), row_east = east(row);
+  const auto row_sum = row_west ^ row_east, row_carry = row_west & row_east;
+  full_add(above_sum, below_sum, row_sum, ones_carry);
+  const auto twos = full_add(above_carry, below_carry, row_carry, twos_carry);
+  const auto fours = twos_carry | (twos & ones_carry);
+  return row[1] & ~fours;
+}
+
+// `accessible()` rolls of a row, 4 words at a time in between the first and
+// last words. Bits outside the grid are 0, and so is anything beyond the row.
+size_t count_accessible(std::span<const uint64_t> above,
+                        std::span<const uint64_t> row,
+                        std::span<const uint64_t> below) {
+  const auto n = row.size();
+  const auto scalar = [&](size_t w) {
+    const auto window = [&](std::span<const uint64_t> words) {
+      // w - 1 wraps around for the first word
+      return std::array{w - 1 < n ? words[w - 1] : 0, words[w],
+                        w + 1 < n ? words[w + 1] : 0};
+    };
+    return static_cast<size_t>(std::popcount(
+        accessible<uint64_t>(window(above), window(row), window(below))));
+  };
+  const auto vector = [&](size_t w) {
+    const auto load = [&](std::span<const uint64_t> words, size_t i) {
+      u64x4 v;
+      std::memcpy(&v, &words[i], sizeof(v));
+      return v;
+    };
+    const auto window = [&](std::span<const uint64_t> words) {
+      return std::array{load(words, w - 1), load(words, w), load(words, w + 1)};
+    };
+    const auto mask =
+        accessible<u64x4>(window(above), window(row), window(below));
+    size_t count = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      count += std::popcount(mask[lane]);
+    }
+    return count;
+  };
+  size_t count = scalar(0), w = 1;
+  for (; w + lanes < n; w += lanes) {
+    count += vector(w);
+  }
+  for (; w < n; ++w) {
+    count += scalar(w);
+  }
+  return count;
+}
+
+// Part 1 on the grid's words: 64 cells per word, with the neighbour counts of
+// all of them computed at once, over chunks of rows on every hardware thread.
+// Needs the padding rows above and below the grid.
+// Time: O(rows * cols / 64 / threads)
+size_t part_1_bitboard(const aoc::BitGrid &grid) {
+  const size_t min_chunk = std::max<size_t>(1, (1 << 16) / grid.cols());
+  const auto chunks =
+      aoc::map_chunks(grid.rows(), min_chunk, [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for (ptrdiff_t r = begin; r < static_cast<ptrdiff_t>(end); ++r) {
+          count += count_accessible(grid.row_words(r - 1), grid.row_words(r),
+                                    grid.row_words(r + 1));
+        }
+        return count;
+      });
+  aoc::count("chunks", chunks.size());
+  return std::reduce(chunks.cbegin(), chunks.cend(), size_t{0});
+}
+
 // Topological sort in spirit
 // Time: O(rows * cols)
 // Space: O(rows * cols)
-int part_2(const std::vector<std::vector<bool>> &grid) {
-  const int rows = grid.size(), cols = grid[0].size();
+// All the hash nodes live in one arena, released in bulk at the end.
+int part_2(const aoc::BitGrid &grid) {
+  const int rows = grid.rows(), cols = grid.cols();
   // we number grid[i][j] as i * cols + j
   const auto to_id = [&](int r, int c) { return r * cols + c; };
-  std::unordered_map<int, std::unordered_set<int>> adjacency_list;
+  aoc::Arena arena;
+  std::pmr::unordered_map<int, std::pmr::unordered_set<int>> adjacency_list(
+      &arena);
   int total = 0;
   // first, build the graph
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
-      if (!grid[r][c]) {
+      if (!grid(r, c)) {
         continue;
       }
       for (int dr = -1; dr <= 1; ++dr) {
@@ -49,11 +163,8 @@ int part_2(const std::vector<std::vector<bool>> &grid) {
           if (dr == 0 && dc == 0) {
             continue;
           }
-          int nr = r + dr, nc = c + dc;
-          if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) {
-            continue;
-          }
-          if (grid[nr][nc]) {
+          const int nr = r + dr, nc = c + dc;
+          if (grid(nr, nc)) {
             adjacency_list[to_id(r, c)].insert(to_id(nr, nc));
             adjacency_list[to_id(nr, nc)].insert(to_id(r, c));
           }
@@ -68,15 +179,16 @@ int part_2(const std::vector<std::vector<bool>> &grid) {
   }
   // now we just need to eliminate nodes with degree <= 3 iteratively
   // we start with nodes whose initial degree <= 3
-  std::unordered_set<int> to_process;
+  std::pmr::unordered_set<int> to_process(&arena);
   for (const auto &[node, neighbors] : adjacency_list) {
     if (neighbors.size() <= 3) {
       to_process.insert(node);
     }
   }
   // roughly BFS
+  decltype(to_process) next_to_process(&arena);
   while (!to_process.empty()) {
-    decltype(to_process) next_to_process;
+    next_to_process.clear();
     for (const auto node : to_process) {
       // skip if already removed. This is necessary as we might try to add a
       // node already in `to_process` to `next_to_process`
@@ -95,30 +207,125 @@ int part_2(const std::vector<std::vector<bool>> &grid) {
     }
     std::swap(to_process, next_to_process);
   }
+  arena.report();
   return total;
 }
 
-int main() {
-  std::vector<std::vector<bool>> grid;
-  for (std::string input; std::cin >> input;) {
-    std::vector<bool> row;
-    row.reserve(input.size());
-    for (const auto c : input) {
-      row.emplace_back(c == '@');
+// a degree that no empty cell gets down to 3, whatever is removed around it
+constexpr uint8_t empty_cell = 0x80;
+
+// Part 2 as k-core peeling on flat arrays: one byte per cell holds the
+// number of neighbouring rolls (or `empty_cell`), and a worklist the rolls to
+// remove. Removing a roll decrements its neighbours' degrees in place, and a
+// neighbour joins the worklist as its degree drops to 3, so only once.
+//
+// With `parallel`, the worklist goes in rounds, each round's frontier split
+// across hardware threads with atomic decrements. That removes rolls in
+// another order, but the same ones.
+// Time: O(rows * cols)
+// Space: 1 byte per cell, plus 8 per removed roll
+size_t part_2_peel(const aoc::BitGrid &grid, bool parallel) {
+  const int rows = grid.rows(), cols = grid.cols();
+  aoc::Grid<uint8_t> degrees(rows, cols, empty_cell, 1);
+  std::vector<size_t> worklist;
+  // the rolls in each column of rows r - 1 to r + 1, padding included
+  std::vector<uint8_t> column_rolls(cols + 2);
+  for (int r = 0; r < rows; ++r) {
+    for (int c = -1; c <= cols; ++c) {
+      column_rolls[c + 1] = grid(r - 1, c) + grid(r, c) + grid(r + 1, c);
     }
-    grid.emplace_back(row);
+    for (int c = 0; c < cols; ++c) {
+      if (!grid(r, c)) {
+        continue;
+      }
+      const uint8_t degree =
+          column_rolls[c] + column_rolls[c + 1] + column_rolls[c + 2] - 1;
+      degrees(r, c) = degree;
+      if (degree <= 3) {
+        worklist.push_back(degrees.flat_index(r, c));
+      }
+    }
+  }
+  const ptrdiff_t stride = degrees.stride();
+  const std::array<ptrdiff_t, 8> neighbours{
+      -stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1};
+  const auto cells = degrees.flat();
+
+  if (!parallel) {
+    for (size_t i = 0; i < worklist.size(); ++i) {
+      for (const auto offset : neighbours) {
+        const auto cell = worklist[i] + offset;
+        if (--cells[cell] == 3) {
+          worklist.push_back(cell);
+        }
+      }
+    }
+    return worklist.size();
+  }
+
+  constexpr size_t min_chunk = 1 << 14;
+  size_t removed = 0, rounds = 0;
+  for (; !worklist.empty(); ++rounds) {
+    removed += worklist.size();
+    const auto chunks = aoc::map_chunks(
+        worklist.size(), min_chunk, [&](size_t begin, size_t end) {
+          std::vector<size_t> next;
+          for (size_t i = begin; i < end; ++i) {
+            for (const auto offset : neighbours) {
+              const auto cell = worklist[i] + offset;
+              // only one thread sees it drop to 3
+              if (std::atomic_ref(cells[cell]).fetch_sub(
+                      1, std::memory_order_relaxed) == 4) {
+                next.push_back(cell);
+              }
+            }
+          }
+          return next;
+        });
+    worklist.clear();
+    for (const auto &next : chunks) {
+      worklist.insert(worklist.end(), next.cbegin(), next.cend());
+    }
+  }
+  aoc::count("rounds", rounds);
+  return removed;
+}
+
+auto parse(std::string_view text) {
+  std::vector<std::string_view> lines;
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    lines.push_back(scanner.token());
   }
   // make sure the grid is rectangular
-  if (grid.empty() ||
-      (std::any_of(grid.cbegin(), grid.cend(), [&](const auto &row) {
-        return row.size() != grid[0].size();
+  if (lines.empty() ||
+      (std::any_of(lines.cbegin(), lines.cend(), [&](const auto &line) {
+        return line.size() != lines[0].size();
       }))) {
-    std::cerr << "Invalid input! The grid is not rectangular." << std::endl;
-    return 1;
+    throw std::runtime_error("Invalid input! The grid is not rectangular.");
   }
-  std::cout << "Grid size: " << grid.size() << " x " << grid.front().size()
-            << std::endl;
-  std::cout << "Part 1: " << part_1(grid) << std::endl;
-  std::cout << "Part 2: " << part_2(grid) << std::endl;
-  return 0;
+  // padded by one empty cell, for the neighbour scans
+  aoc::BitGrid grid(lines.size(), lines[0].size(), 1);
+  for (size_t r = 0; r < lines.size(); ++r) {
+    for (size_t c = 0; c < lines[r].size(); ++c) {
+      grid.set(r, c, lines[r][c] == '@');
+    }
+  }
+  return grid;
+}
+
+int run_day(aoc::Runner &runner) {
+  const auto &grid = runner.parse(parse);
+  aoc::count("rows", grid.rows());
+  aoc::count("cols", grid.cols());
+  runner.part(1, "part_1", [&] { return part_1(grid); });
+  runner.part(1, "part_1_bitboard", [&] { return part_1_bitboard(grid); });
+  runner.part(2, "part_2", [&] { return part_2(grid); });
+  runner.part(2, "part_2_peel", [&] { return part_2_peel(grid, false); });
+  runner.part(2, "part_2_peel_parallel",
+              [&] { return part_2_peel(grid, true); });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 4, run_day)
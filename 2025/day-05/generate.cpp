@@ -0,0 +1,22 @@
+// Generates SIZE "start-end" intervals, a blank line, then SIZE values. The
+// intervals overlap often enough that merging them matters.
+#include "common/generate.hpp"
+#include <algorithm>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr uint64_t max_value = 1'000'000'000'000'000;
+    aoc::Random random{args.seed};
+    // keep the total covered length around half of the value space
+    const auto max_length = max_value / std::max<uint64_t>(args.size, 1);
+    for (uint64_t i = 0; i < args.size; ++i) {
+      const auto start = random.between<uint64_t>(1, max_value);
+      const auto end = start + random.between<uint64_t>(0, max_length);
+      out << start << '-' << end << '\n';
+    }
+    out << '\n';
+    for (uint64_t i = 0; i < args.size; ++i) {
+      out << random.between<uint64_t>(1, max_value) << '\n';
+    }
+  });
+}
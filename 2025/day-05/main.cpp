@@ -1,10 +1,27 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include "common/tasks.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <ranges>
-#include <sstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+namespace {
+
 template <typename T> struct Interval {
   T start;
   T end;
@@ -14,14 +31,28 @@ template <typename T> struct Interval {
   }
 
   // input format : start-end
-  friend std::istream &operator>>(std::istream &is, Interval &interval) {
-    char dash;
-    is >> interval.start >> dash >> interval.end;
-    // make sure the separator is dash and the interval is valid
-    if (dash != '-' || interval.start > interval.end) {
-      is.setstate(std::ios::failbit);
+  static std::optional<Interval> parse(std::string_view line) {
+    aoc::Scanner scanner{line};
+    Interval interval;
+    if (const auto start = scanner.try_number<T>()) {
+      interval.start = *start;
+    } else {
+      return std::nullopt;
+    }
+    // make sure the separator is dash
+    if (!scanner.consume('-')) {
+      return std::nullopt;
+    }
+    if (const auto end = scanner.try_number<T>()) {
+      interval.end = *end;
+    } else {
+      return std::nullopt;
+    }
+    // make sure the interval is valid and nothing follows it
+    if (interval.start > interval.end || !scanner.done()) {
+      return std::nullopt;
     }
-    return is;
+    return interval;
   }
 };
 
@@ -40,46 +71,680 @@ int part_1(const std::vector<Interval<T>> &intervals,
   return total;
 }
 
-template <typename T> T part_2(std::vector<Interval<T>> intervals) {
-  if (intervals.empty()) {
-    return 0;
-  }
+// Sorted, disjoint intervals covering the same values, which only depend on
+// the input and so are derived once and shared, see `run_day()`.
+// Time: O(n log n)
+template <typename T>
+std::vector<Interval<T>> merge(std::vector<Interval<T>> intervals) {
   std::sort(intervals.begin(), intervals.end());
-  T total = 0;
-  T lo = intervals.front().start, hi = intervals.front().end;
-  for (const auto &interval : intervals | std::views::drop(1)) {
-    if (interval.start > hi) {
-      total += hi - lo + 1;
-      lo = interval.start;
-      hi = interval.end;
+  std::vector<Interval<T>> merged;
+  for (const auto &interval : intervals) {
+    if (merged.empty() || interval.start > merged.back().end) {
+      merged.push_back(interval);
     } else {
-      hi = std::max(hi, interval.end);
+      merged.back().end = std::max(merged.back().end, interval.end);
+    }
+  }
+  return merged;
+}
+
+// LSD radix sort of the intervals by their starts, a byte per pass, ping-
+// ponging between `intervals` and a buffer of the same size. Every pass
+// counts the digits of each chunk on its own thread, then each thread
+// scatters its chunk to the offsets it got from the counts, which keeps the
+// sort stable. Passes where all starts share the digit are skipped, which
+// with small starts are most of them.
+// Time: O(n * sizeof(T) / threads)
+template <typename T> void radix_sort(std::vector<Interval<T>> &intervals) {
+  static_assert(std::is_unsigned_v<T>);
+  constexpr size_t radix = 256;
+  constexpr size_t passes = sizeof(T);
+  constexpr size_t min_chunk = 1 << 16;
+  using Counts = std::array<size_t, radix>;
+  const auto digit = [](T start, size_t pass) {
+    return static_cast<size_t>(start >> (8 * pass)) & (radix - 1);
+  };
+
+  // which passes change anything, from the digits of all passes at once
+  const auto all_counts = aoc::map_chunks(
+      intervals.size(), min_chunk, [&](size_t begin, size_t end) {
+        std::array<Counts, passes> counts{};
+        for (size_t i = begin; i < end; ++i) {
+          for (size_t pass = 0; pass < passes; ++pass) {
+            ++counts[pass][digit(intervals[i].start, pass)];
+          }
+        }
+        return counts;
+      });
+
+  std::vector<Interval<T>> buffer(intervals.size());
+  for (size_t pass = 0; pass < passes; ++pass) {
+    Counts total{};
+    for (const auto &counts : all_counts) {
+      for (size_t d = 0; d < radix; ++d) {
+        total[d] += counts[pass][d];
+      }
     }
+    if (std::ranges::find(total, intervals.size()) != total.end()) {
+      continue;
+    }
+    // the chunks are the same for both calls, as their sizes are
+    auto counts = aoc::map_chunks(
+        intervals.size(), min_chunk, [&](size_t begin, size_t end) {
+          Counts counts{};
+          for (size_t i = begin; i < end; ++i) {
+            ++counts[digit(intervals[i].start, pass)];
+          }
+          return std::pair{begin, counts};
+        });
+    // turn the counts into where each chunk writes each digit
+    size_t offset = 0;
+    for (size_t d = 0; d < radix; ++d) {
+      for (auto &[begin, chunk_counts] : counts) {
+        offset += std::exchange(chunk_counts[d], offset);
+      }
+    }
+    aoc::map_chunks(intervals.size(), min_chunk, [&](size_t begin, size_t end) {
+      auto offsets =
+          std::ranges::find_if(counts, [&](const auto &chunk) {
+            return chunk.first == begin;
+          })->second;
+      for (size_t i = begin; i < end; ++i) {
+        buffer[offsets[digit(intervals[i].start, pass)]++] = intervals[i];
+      }
+      return 0;
+    });
+    intervals.swap(buffer);
+  }
+}
+
+// `merge()` with a radix sort, and each thread coalescing a slice of the
+// sorted intervals on its own. Stitching the slices together then only
+// merges the intervals of each slice that overlap the ones before it.
+// Time: O(n / threads + merged intervals)
+template <typename T>
+std::vector<Interval<T>> merge_parallel(std::vector<Interval<T>> intervals) {
+  radix_sort(intervals);
+  constexpr size_t min_chunk = 1 << 16;
+  const auto slices = aoc::map_chunks(
+      intervals.size(), min_chunk, [&](size_t begin, size_t end) {
+        std::vector<Interval<T>> merged;
+        for (size_t i = begin; i < end; ++i) {
+          if (merged.empty() || intervals[i].start > merged.back().end) {
+            merged.push_back(intervals[i]);
+          } else {
+            merged.back().end = std::max(merged.back().end, intervals[i].end);
+          }
+        }
+        return merged;
+      });
+  std::vector<Interval<T>> merged;
+  for (const auto &slice : slices) {
+    auto it = slice.cbegin();
+    for (; it != slice.cend() && !merged.empty() &&
+           it->start <= merged.back().end;
+         ++it) {
+      merged.back().end = std::max(merged.back().end, it->end);
+    }
+    merged.insert(merged.end(), it, slice.cend());
+  }
+  return merged;
+}
+
+// Binary search for the last merged interval starting at or before each
+// value.
+// Time: O(m log n)
+template <typename T>
+int part_1_merged(const std::vector<Interval<T>> &merged,
+                  const std::vector<T> &values) {
+  int total = 0;
+  for (const auto &value : values) {
+    const auto it = std::upper_bound(
+        merged.cbegin(), merged.cend(), value,
+        [](const T &v, const Interval<T> &interval) {
+          return v < interval.start;
+        });
+    total += (it != merged.cbegin() && value <= std::prev(it)->end);
   }
-  total += hi - lo + 1;
   return total;
 }
 
-int main() {
-  using value_t = uint64_t;
+// Merged intervals laid out for point lookups. The starts are in Eytzinger
+// order, i.e. the implicit binary tree of a heap stored level by level, so a
+// search walks down from the root without branches and the top levels share
+// a few cache lines. Next to each start (at the same index of `stops`) is
+// one past the end of the interval before it, which is all a lookup needs to
+// check once it knows the first start above the value.
+template <typename T> class IntervalIndex {
+private:
+  std::vector<Interval<T>> merged;
+  // [1, n], in Eytzinger order
+  std::vector<T> starts;
+  // 0 for the first interval, as no value is below that
+  std::vector<T> stops;
+
+  // fill the subtree of node k in order, from merged[i] on
+  void build(size_t &i, size_t k) {
+    if (k < starts.size()) {
+      build(i, 2 * k);
+      starts[k] = merged[i].start;
+      stops[k] = i > 0 ? merged[i - 1].end + 1 : 0;
+      ++i;
+      build(i, 2 * k + 1);
+    }
+  }
+
+public:
+  // `merged` is sorted and disjoint, see `merge()`
+  explicit IntervalIndex(std::vector<Interval<T>> merged)
+      : merged(std::move(merged)), starts(this->merged.size() + 1),
+        stops(this->merged.size() + 1) {
+    size_t i = 0;
+    build(i, 1);
+  }
+
+  const std::vector<Interval<T>> &intervals() const { return merged; }
+
+  // Time: O(log n), with the nodes 3 levels down prefetched on the way
+  bool contains(T value) const {
+    const size_t n = merged.size();
+    size_t k = 1;
+    while (k <= n) {
+      // a node's 8 great-grandchildren are adjacent
+      __builtin_prefetch(starts.data() + 8 * k);
+      k = 2 * k + (starts[k] <= value);
+    }
+    // drop the right turns after the last left one, which leaves the first
+    // start above the value (or 0 if there's none)
+    k >>= std::countr_one(k) + 1;
+    return k ? value < stops[k] : n > 0 && value <= merged.back().end;
+  }
+
+  // Time: O(m log n)
+  size_t count_contained(std::span<const T> values) const {
+    return std::count_if(values.begin(), values.end(),
+                         [&](T value) { return contains(value); });
+  }
+
+  // The batch version: sort the values, then walk them and the intervals
+  // side by side.
+  // Time: O(m log m + n)
+  size_t count_contained_batch(std::vector<T> values) const {
+    std::sort(values.begin(), values.end());
+    size_t count = 0;
+    auto interval = merged.cbegin();
+    for (const auto value : values) {
+      while (interval != merged.cend() && interval->end < value) {
+        ++interval;
+      }
+      count += interval != merged.cend() && interval->start <= value;
+    }
+    return count;
+  }
+};
+
+// `IntervalIndex::contains()` for chunks of the values on every hardware
+// thread.
+// Time: O(m log n / threads)
+template <typename T>
+size_t part_1_index(const IntervalIndex<T> &index,
+                    const std::vector<T> &values) {
+  constexpr size_t min_chunk = 1 << 14;
+  const auto chunks =
+      aoc::map_chunks(values.size(), min_chunk, [&](size_t begin, size_t end) {
+        return index.count_contained(
+            std::span(values).subspan(begin, end - begin));
+      });
+  return std::reduce(chunks.cbegin(), chunks.cend(), size_t{0});
+}
+
+// A set of values kept as coalesced, disjoint intervals, for ranges that come
+// and go one at a time. The intervals live in a B+ tree keyed by their
+// starts: leaves pack up to `capacity` intervals and are linked in order,
+// inner nodes pack the keys next to their children's indices, and all nodes
+// are stored in two vectors, with freed ones reused.
+//
+// The keys of inner nodes are lower bounds: keys[i] is at most every start in
+// child i and above every start in child i - 1, while keys[0] is unused.
+// Erasing the first interval of a leaf doesn't update them.
+template <typename T> class IntervalSet {
+private:
+  static constexpr size_t capacity = 16;
+  // for every node but the root
+  static constexpr size_t min_size = capacity / 2;
+  static constexpr uint32_t none = UINT32_MAX;
+
+  struct Leaf {
+    uint32_t size = 0;
+    uint32_t prev = none;
+    uint32_t next = none;
+    std::array<Interval<T>, capacity> items;
+  };
+
+  struct Inner {
+    uint32_t size = 0;
+    std::array<T, capacity> keys;
+    std::array<uint32_t, capacity> children;
+  };
+
+  // leaf 0 is always the first one, as splits and merges keep the left node
+  std::vector<Leaf> leaves = std::vector<Leaf>(1);
+  std::vector<Inner> inners;
+  std::vector<uint32_t> free_leaves;
+  std::vector<uint32_t> free_inners;
+  uint32_t root = 0;
+  // the root is a leaf at height 0
+  size_t height = 0;
+  size_t count = 0;
+  T covered_ = 0;
+
+  static T length(const Interval<T> &interval) {
+    return interval.end - interval.start + 1;
+  }
+
+  // the last child whose key is at most `start`, or the first one
+  static size_t child_of(const Inner &node, T start) {
+    return std::upper_bound(node.keys.begin() + 1,
+                            node.keys.begin() + node.size, start) -
+           node.keys.begin() - 1;
+  }
+
+  template <typename Node>
+  static uint32_t allocate(std::vector<Node> &nodes,
+                           std::vector<uint32_t> &free) {
+    if (free.empty()) {
+      nodes.emplace_back();
+      return nodes.size() - 1;
+    }
+    const auto index = free.back();
+    free.pop_back();
+    nodes[index] = Node{};
+    return index;
+  }
+
+  // the leaf whose range of starts covers `start`
+  uint32_t find_leaf(T start) const {
+    auto node = root;
+    for (size_t level = height; level > 0; --level) {
+      const auto &inner = inners[node];
+      node = inner.children[child_of(inner, start)];
+    }
+    return node;
+  }
+
+  // The last interval starting at or before `value`, if any. Invalidated by
+  // any update.
+  Interval<T> *find_last(T value) {
+    auto &leaf = leaves[find_leaf(value)];
+    const auto it =
+        std::upper_bound(leaf.items.begin(), leaf.items.begin() + leaf.size,
+                         value, [](T v, const Interval<T> &interval) {
+                           return v < interval.start;
+                         });
+    if (it != leaf.items.begin()) {
+      return &*std::prev(it);
+    }
+    // the keys are lower bounds, so the interval can be in the leaf before
+    if (leaf.prev == none) {
+      return nullptr;
+    }
+    auto &prev = leaves[leaf.prev];
+    return &prev.items[prev.size - 1];
+  }
+
+  const Interval<T> *find_last(T value) const {
+    return const_cast<IntervalSet *>(this)->find_last(value);
+  }
+
+  // Inserts an interval (not overlapping any other) into the subtree of
+  // `node`. If the node had to split, returns the key and index of its new
+  // right sibling.
+  std::optional<std::pair<T, uint32_t>>
+  insert_into(uint32_t node, size_t level, const Interval<T> &interval) {
+    if (level == 0) {
+      auto *leaf = &leaves[node];
+      const auto pos =
+          std::upper_bound(leaf->items.begin(),
+                           leaf->items.begin() + leaf->size, interval) -
+          leaf->items.begin();
+      if (leaf->size < capacity) {
+        std::copy_backward(leaf->items.begin() + pos,
+                           leaf->items.begin() + leaf->size,
+                           leaf->items.begin() + leaf->size + 1);
+        leaf->items[pos] = interval;
+        ++leaf->size;
+        return std::nullopt;
+      }
+      // split the capacity + 1 intervals in two
+      std::array<Interval<T>, capacity + 1> items;
+      std::copy(leaf->items.begin(), leaf->items.begin() + pos, items.begin());
+      items[pos] = interval;
+      std::copy(leaf->items.begin() + pos, leaf->items.end(),
+                items.begin() + pos + 1);
+      const auto right_index = allocate(leaves, free_leaves);
+      leaf = &leaves[node];
+      auto &right = leaves[right_index];
+      constexpr size_t half = (capacity + 1) / 2;
+      leaf->size = half;
+      right.size = capacity + 1 - half;
+      std::copy(items.begin(), items.begin() + half, leaf->items.begin());
+      std::copy(items.begin() + half, items.end(), right.items.begin());
+      right.prev = node;
+      right.next = leaf->next;
+      if (leaf->next != none) {
+        leaves[leaf->next].prev = right_index;
+      }
+      leaf->next = right_index;
+      return std::pair{right.items[0].start, right_index};
+    }
+
+    const auto pos = child_of(inners[node], interval.start);
+    const auto split =
+        insert_into(inners[node].children[pos], level - 1, interval);
+    if (!split) {
+      return std::nullopt;
+    }
+    auto *inner = &inners[node];
+    if (inner->size < capacity) {
+      std::copy_backward(inner->keys.begin() + pos + 1,
+                         inner->keys.begin() + inner->size,
+                         inner->keys.begin() + inner->size + 1);
+      std::copy_backward(inner->children.begin() + pos + 1,
+                         inner->children.begin() + inner->size,
+                         inner->children.begin() + inner->size + 1);
+      inner->keys[pos + 1] = split->first;
+      inner->children[pos + 1] = split->second;
+      ++inner->size;
+      return std::nullopt;
+    }
+    std::array<T, capacity + 1> keys;
+    std::array<uint32_t, capacity + 1> children;
+    std::copy(inner->keys.begin(), inner->keys.begin() + pos + 1,
+              keys.begin());
+    std::copy(inner->children.begin(), inner->children.begin() + pos + 1,
+              children.begin());
+    keys[pos + 1] = split->first;
+    children[pos + 1] = split->second;
+    std::copy(inner->keys.begin() + pos + 1, inner->keys.end(),
+              keys.begin() + pos + 2);
+    std::copy(inner->children.begin() + pos + 1, inner->children.end(),
+              children.begin() + pos + 2);
+    const auto right_index = allocate(inners, free_inners);
+    inner = &inners[node];
+    auto &right = inners[right_index];
+    constexpr size_t half = (capacity + 1) / 2;
+    inner->size = half;
+    right.size = capacity + 1 - half;
+    std::copy(keys.begin(), keys.begin() + half, inner->keys.begin());
+    std::copy(children.begin(), children.begin() + half,
+              inner->children.begin());
+    std::copy(keys.begin() + half, keys.end(), right.keys.begin());
+    std::copy(children.begin() + half, children.end(),
+              right.children.begin());
+    return std::pair{keys[half], right_index};
+  }
+
+  void insert_one(const Interval<T> &interval) {
+    if (const auto split = insert_into(root, height, interval)) {
+      const auto new_root = allocate(inners, free_inners);
+      auto &inner = inners[new_root];
+      inner.size = 2;
+      inner.children[0] = root;
+      inner.keys[1] = split->first;
+      inner.children[1] = split->second;
+      root = new_root;
+      ++height;
+    }
+    ++count;
+    covered_ += length(interval);
+  }
+
+  // Refills child i of `parent`, at `level`, which fell below `min_size`:
+  // either by moving one entry over from a sibling, or by merging the two.
+  void rebalance(uint32_t parent, size_t i, size_t level) {
+    auto &node = inners[parent];
+    const size_t l = i > 0 ? i - 1 : 0;
+    const size_t r = l + 1;
+    const auto left_index = node.children[l];
+    const auto right_index = node.children[r];
+    if (level == 0) {
+      auto &left = leaves[left_index];
+      auto &right = leaves[right_index];
+      if (left.size + right.size <= capacity) {
+        std::copy(right.items.begin(), right.items.begin() + right.size,
+                  left.items.begin() + left.size);
+        left.size += right.size;
+        left.next = right.next;
+        if (right.next != none) {
+          leaves[right.next].prev = left_index;
+        }
+        free_leaves.push_back(right_index);
+      } else {
+        if (left.size < right.size) {
+          left.items[left.size++] = right.items[0];
+          std::copy(right.items.begin() + 1, right.items.begin() + right.size,
+                    right.items.begin());
+          --right.size;
+        } else {
+          std::copy_backward(right.items.begin(),
+                             right.items.begin() + right.size,
+                             right.items.begin() + right.size + 1);
+          right.items[0] = left.items[--left.size];
+          ++right.size;
+        }
+        node.keys[r] = right.items[0].start;
+        return;
+      }
+    } else {
+      auto &left = inners[left_index];
+      auto &right = inners[right_index];
+      // the key of right's first child is in the parent
+      right.keys[0] = node.keys[r];
+      if (left.size + right.size <= capacity) {
+        std::copy(right.keys.begin(), right.keys.begin() + right.size,
+                  left.keys.begin() + left.size);
+        std::copy(right.children.begin(), right.children.begin() + right.size,
+                  left.children.begin() + left.size);
+        left.size += right.size;
+        free_inners.push_back(right_index);
+      } else {
+        if (left.size < right.size) {
+          left.keys[left.size] = right.keys[0];
+          left.children[left.size++] = right.children[0];
+          std::copy(right.keys.begin() + 1, right.keys.begin() + right.size,
+                    right.keys.begin());
+          std::copy(right.children.begin() + 1,
+                    right.children.begin() + right.size,
+                    right.children.begin());
+          --right.size;
+        } else {
+          std::copy_backward(right.keys.begin(),
+                             right.keys.begin() + right.size,
+                             right.keys.begin() + right.size + 1);
+          std::copy_backward(right.children.begin(),
+                             right.children.begin() + right.size,
+                             right.children.begin() + right.size + 1);
+          --left.size;
+          right.keys[0] = left.keys[left.size];
+          right.children[0] = left.children[left.size];
+          ++right.size;
+        }
+        node.keys[r] = right.keys[0];
+        return;
+      }
+    }
+    // the right node was merged into the left one
+    std::copy(node.keys.begin() + r + 1, node.keys.begin() + node.size,
+              node.keys.begin() + r);
+    std::copy(node.children.begin() + r + 1, node.children.begin() + node.size,
+              node.children.begin() + r);
+    --node.size;
+  }
+
+  // Erases the interval starting at `start` from the subtree of `node`.
+  // Returns whether the node fell below `min_size`.
+  bool erase_from(uint32_t node, size_t level, T start) {
+    if (level == 0) {
+      auto &leaf = leaves[node];
+      const auto it = std::find_if(
+          leaf.items.begin(), leaf.items.begin() + leaf.size,
+          [&](const Interval<T> &interval) { return interval.start == start; });
+      std::copy(it + 1, leaf.items.begin() + leaf.size, it);
+      --leaf.size;
+      return leaf.size < min_size;
+    }
+    const auto pos = child_of(inners[node], start);
+    if (erase_from(inners[node].children[pos], level - 1, start)) {
+      rebalance(node, pos, level - 1);
+    }
+    return inners[node].size < min_size;
+  }
+
+  // by value, as it may point into the leaf it is erased from
+  void erase_one(Interval<T> interval) {
+    erase_from(root, height, interval.start);
+    if (height > 0 && inners[root].size == 1) {
+      free_inners.push_back(root);
+      root = inners[root].children[0];
+      --height;
+    }
+    --count;
+    covered_ -= length(interval);
+  }
+
+public:
+  // Adds the values of `interval`, merging it with every interval it overlaps
+  // or touches.
+  // Time: O(log n), amortized over the intervals it absorbs
+  void insert(Interval<T> interval) {
+    auto [start, end] = interval;
+    // the intervals to absorb are the last ones starting at or before end + 1
+    const T last_start = end < std::numeric_limits<T>::max() ? end + 1 : end;
+    for (auto *last = find_last(last_start);
+         last && (last->end >= start || last->end + 1 == start);
+         last = find_last(last_start)) {
+      if (last->start <= start && last->end >= end) {
+        // already covered
+        return;
+      }
+      start = std::min(start, last->start);
+      end = std::max(end, last->end);
+      erase_one(*last);
+    }
+    insert_one({start, end});
+  }
+
+  // Removes the values of `interval`, trimming or splitting the intervals
+  // it overlaps.
+  // Time: O(log n), amortized over the intervals it removes
+  void erase(Interval<T> interval) {
+    for (auto *last = find_last(interval.end);
+         last && last->end >= interval.start;
+         last = find_last(interval.end)) {
+      const auto old = *last;
+      if (old.start < interval.start) {
+        // keep the part before, in place as its start doesn't change
+        last->end = interval.start - 1;
+        covered_ -= old.end - last->end;
+      } else {
+        erase_one(old);
+      }
+      if (old.end > interval.end) {
+        // keep the part after
+        insert_one({interval.end + 1, old.end});
+      }
+    }
+  }
+
+  // Time: O(log n)
+  bool contains(T value) const {
+    const auto *last = find_last(value);
+    return last && value <= last->end;
+  }
+
+  // the number of values in the set, i.e. the part 2 answer
+  T covered() const { return covered_; }
+
+  // the number of disjoint intervals
+  size_t size() const { return count; }
+
+  // Time: O(n)
+  std::vector<Interval<T>> intervals() const {
+    std::vector<Interval<T>> result;
+    result.reserve(count);
+    for (auto leaf = uint32_t{0}; leaf != none; leaf = leaves[leaf].next) {
+      result.insert(result.end(), leaves[leaf].items.begin(),
+                    leaves[leaf].items.begin() + leaves[leaf].size);
+    }
+    return result;
+  }
+};
+
+template <typename T> T part_2(const std::vector<Interval<T>> &merged) {
+  T total = 0;
+  for (const auto &interval : merged) {
+    total += interval.end - interval.start + 1;
+  }
+  return total;
+}
+
+using value_t = uint64_t;
+
+auto parse(std::string_view text) {
+  // intervals and values are separated by a blank line
+  const auto separator = text.find("\n\n");
+  const auto interval_block = text.substr(0, separator);
+  const auto value_block = separator == std::string_view::npos
+                               ? std::string_view{}
+                               : text.substr(separator + 2);
   std::vector<Interval<value_t>> intervals;
-  std::string line;
-  while (std::getline(std::cin, line) && !line.empty()) {
-    std::istringstream iss{line};
-    Interval<value_t> interval;
-    if (!(iss >> interval)) {
-      std::cerr << "Invalid interval input: " << line << std::endl;
-      return 1;
+  for (const auto line : aoc::lines(interval_block)) {
+    const auto interval = Interval<value_t>::parse(line);
+    if (!interval) {
+      throw std::runtime_error("Invalid interval input: " + std::string(line));
     }
-    intervals.emplace_back(interval);
+    intervals.emplace_back(*interval);
   }
   std::vector<value_t> values;
-  for (value_t v; std::cin >> v;) {
-    values.emplace_back(v);
-  }
-  std::cout << "Total intervals: " << intervals.size() << std::endl;
-  std::cout << "Total values: " << values.size() << std::endl;
-  std::cout << "Part 1: " << part_1(intervals, values) << std::endl;
-  std::cout << "Part 2: " << part_2(intervals) << std::endl;
-  return 0;
+  for (aoc::Scanner scanner{value_block}; !scanner.done();) {
+    values.emplace_back(scanner.number<value_t>());
+  }
+  return std::pair{intervals, values};
 }
+
+int run_day(aoc::Runner &runner) {
+  const auto &[intervals, values] = runner.parse(parse);
+  aoc::count("intervals", intervals.size());
+  aoc::count("values", values.size());
+  const auto &merged =
+      runner.derive("merged_intervals", [&] { return merge(intervals); });
+  aoc::count("merged_intervals", merged.size());
+  const auto &index = runner.derive(
+      "interval_index", [&] { return IntervalIndex<value_t>(merged); });
+  const auto &set = runner.derive("interval_set", [&] {
+    IntervalSet<value_t> set;
+    for (const auto &interval : intervals) {
+      set.insert(interval);
+    }
+    return set;
+  });
+  runner.part(1, "part_1", [&] { return part_1(intervals, values); });
+  runner.part(1, "part_1_merged",
+              [&] { return part_1_merged(merged, values); });
+  runner.part(1, "part_1_index", [&] { return part_1_index(index, values); });
+  runner.part(1, "part_1_batch",
+              [&] { return index.count_contained_batch(values); });
+  runner.part(1, "part_1_set", [&] {
+    return std::count_if(values.cbegin(), values.cend(),
+                         [&](value_t value) { return set.contains(value); });
+  });
+  runner.part(2, "part_2", [&] { return part_2(merged); });
+  runner.part(2, "part_2_set", [&] { return set.covered(); });
+  runner.part(2, "part_2_parallel",
+              [&] { return part_2(merge_parallel(intervals)); });
+  return runner.finish();
+}
+
+} // namespace
+
+AOC_MAIN(2025, 5, run_day)
@@ -0,0 +1,40 @@
+// Generates a worksheet of SIZE problems over 4 operand rows. Each problem is
+// a block of columns as wide as its longest number, separated by a blank
+// column, with its operator under the block's first column. Numbers use the
+// digits 1-9 and are randomly left- or right-aligned within their block, so
+// every column of a block has at least one digit.
+#include "common/generate.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr int operand_rows = 4, max_digits = 4;
+    aoc::Random random{args.seed};
+    std::vector<std::string> lines(operand_rows + 1);
+    for (uint64_t i = 0; i < args.size; ++i) {
+      std::vector<std::string> numbers(operand_rows);
+      size_t width = 0;
+      for (auto &number : numbers) {
+        number.resize(random.between(1, max_digits));
+        for (auto &digit : number) {
+          digit = static_cast<char>('0' + random.between(1, 9));
+        }
+        width = std::max(width, number.size());
+      }
+      for (int row = 0; row < operand_rows; ++row) {
+        const auto padding = std::string(width - numbers[row].size(), ' ');
+        lines[row] += (i == 0 ? "" : " ");
+        lines[row] += random.chance(0.5) ? numbers[row] + padding
+                                         : padding + numbers[row];
+      }
+      lines.back() += (i == 0 ? "" : " ");
+      lines.back() += random.chance(0.5) ? '*' : '+';
+      lines.back() += std::string(width - 1, ' ');
+    }
+    for (const auto &line : lines) {
+      out << std::string_view(line) << '\n';
+    }
+  });
+}
@@ -1,32 +1,43 @@
+#include "common/grid.hpp"
+#include "common/input.hpp"
+#include "common/runner.hpp"
+#include "common/simd.hpp"
+#include "common/tasks.hpp"
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
-#include <iterator>
+#include <optional>
 #include <ranges>
-#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 auto part_1(const auto &operand_lines, const auto &operator_line) {
   std::vector<bool> multiply_operators;
-  {
-    std::istringstream iss(operator_line);
-    for (std::string token; iss >> token;) {
-      if (token == "+") {
-        multiply_operators.push_back(false);
-      } else if (token == "*") {
-        multiply_operators.push_back(true);
-      } else {
-        throw std::runtime_error("Invalid operator: " + token);
-      }
+  for (aoc::Scanner scanner{operator_line}; !scanner.done();) {
+    const auto token = scanner.token();
+    if (token == "+") {
+      multiply_operators.push_back(false);
+    } else if (token == "*") {
+      multiply_operators.push_back(true);
+    } else {
+      throw std::runtime_error("Invalid operator: " + std::string(token));
     }
   }
   const auto num_operations = multiply_operators.size();
   // parse operands
   std::vector<std::vector<uint64_t>> operands;
   for (const auto &line : operand_lines) {
-    std::istringstream iss(line);
-    std::vector<uint64_t> operand_row{std::istream_iterator<uint64_t>(iss),
-                                      std::istream_iterator<uint64_t>()};
+    std::vector<uint64_t> operand_row;
+    for (aoc::Scanner scanner{line}; !scanner.done();) {
+      operand_row.push_back(scanner.number<uint64_t>());
+    }
     if (operand_row.size() != num_operations) {
       throw std::runtime_error(
           "Operand row size does not match number of operators");
@@ -64,7 +75,10 @@ struct OperatorInfo {
   }
 };
 
-auto part_2(const auto &operand_lines, const auto &operator_line) {
+// The operators and the columns of their problems. Every line has to be as
+// long as the operator line.
+std::vector<OperatorInfo> parse_operators(const auto &operand_lines,
+                                          const auto &operator_line) {
   // asset all lines are of the same length
   const auto line_length = operator_line.size();
   for (const auto &line : operand_lines) {
@@ -92,6 +106,11 @@ auto part_2(const auto &operand_lines, const auto &operator_line) {
                                  2});
     last_op = next_op;
   }
+  return operators;
+}
+
+auto part_2(const auto &operand_lines, const auto &operator_line) {
+  const auto operators = parse_operators(operand_lines, operator_line);
   // for debugging, print parsed operators
   //   std::cout << "\nParsed " << operators.size() << " operators" <<
   //   std::endl; for (const auto &op_info : operators) {
@@ -129,22 +148,258 @@ auto part_2(const auto &operand_lines, const auto &operator_line) {
   return result;
 }
 
-int main() {
-  std::vector<std::string> input_lines;
-  for (std::string line; std::getline(std::cin, line);) {
+constexpr size_t lanes = 8;
+using aoc::i64x8;
+using aoc::i8x8;
+using aoc::u64x8;
+using aoc::u8x8;
+
+// The operand lines transposed into blocks of `lanes` adjacent columns: row
+// b * rows + r of the grid is row r of the columns [b * lanes, (b + 1) *
+// lanes), so a block's rows are contiguous and each is one vector. The last
+// block is padded with blanks. Chunks of blocks are copied on every hardware
+// thread, reading every line forward.
+// Time: O(rows * cols / threads)
+aoc::Grid<char> transpose(const std::vector<std::string_view> &lines,
+                          size_t cols) {
+  constexpr size_t min_chunk = 1 << 12;
+  const auto rows = lines.size();
+  const auto blocks = (cols + lanes - 1) / lanes;
+  aoc::Grid<char> columns(blocks * rows, lanes, ' ');
+  aoc::map_chunks(blocks, min_chunk, [&](size_t begin, size_t end) {
+    for (size_t block = begin; block < end; ++block) {
+      const auto col = block * lanes;
+      const auto width = std::min(lanes, cols - col);
+      for (size_t row = 0; row < rows; ++row) {
+        std::memcpy(columns.row(block * rows + row).data(),
+                    lines[row].data() + col, width);
+      }
+    }
+    return 0;
+  });
+  return columns;
+}
+
+// The operands of the `lanes` columns of a block, each read top to bottom
+// skipping the blanks: Horner's rule down the block's rows, where
+// `is_digit ? operand * 10 + digit : operand` is a blend of the lanes.
+u64x8 block_operands(const aoc::Grid<char> &columns, size_t rows,
+                     size_t block) {
+  u64x8 operand{};
+  for (size_t row = 0; row < rows; ++row) {
+    u8x8 bytes;
+    std::memcpy(&bytes, columns.row(block * rows + row).data(), lanes);
+    // blanks wrap around to 240. Comparing the bytes and shifting instead of
+    // multiplying keeps this quick without AVX-512, which is the first to
+    // have 64-bit lane compares and multiplies.
+    const auto digit = bytes - '0';
+    const auto is_digit =
+        (u64x8)__builtin_convertvector((i8x8)(digit < 10), i64x8);
+    const auto next = (operand << 3) + (operand << 1) +
+                      __builtin_convertvector(digit, u64x8);
+    operand = (next & is_digit) | (operand & ~is_digit);
+  }
+  return operand;
+}
+
+struct Evaluation {
+  uint64_t result = 0;
+  // the first column without digits, if any
+  std::optional<size_t> empty_col;
+};
+
+// `part_2()` on the transposed operands, with the problems split into chunks
+// evaluated on every hardware thread, each computing the operands of its
+// columns a block of `lanes` at a time.
+// Time: O(rows * cols / threads)
+uint64_t part_2_transposed(const auto &operand_lines,
+                           const auto &operator_line) {
+  const auto operators = parse_operators(operand_lines, operator_line);
+  const std::vector<std::string_view> lines(operand_lines.begin(),
+                                            operand_lines.end());
+  const auto cols = operator_line.size();
+  const auto columns = transpose(lines, cols);
+  constexpr size_t min_chunk = 1 << 10;
+  const auto chunks = aoc::map_chunks(
+      operators.size(), min_chunk, [&](size_t begin, size_t end) {
+        Evaluation evaluation;
+        if (begin == end) {
+          return evaluation;
+        }
+        const auto col_begin = operators[begin].start_col;
+        const auto col_end = operators[end - 1].end_col + 1;
+        auto op_info = operators.begin() + begin;
+        uint64_t op_result = op_info->is_multiply;
+        // the blocks at the ends may be shared with the next chunks, which
+        // compute them again
+        for (auto block = col_begin / lanes; block * lanes < col_end;
+             ++block) {
+          const auto operands = block_operands(columns, lines.size(), block);
+          const auto lane_begin = std::max(block * lanes, col_begin);
+          const auto lane_end = std::min((block + 1) * lanes, col_end);
+          for (auto col = lane_begin; col < lane_end; ++col) {
+            if (col > op_info->end_col) {
+              // the blank column before the next operator
+              if (col < (op_info + 1)->start_col) {
+                continue;
+              }
+              evaluation.result += op_result;
+              ++op_info;
+              op_result = op_info->is_multiply;
+            }
+            const auto operand = operands[col % lanes];
+            if (operand == 0 && !evaluation.empty_col) {
+              evaluation.empty_col = col;
+            }
+            op_result = op_info->is_multiply ? op_result * operand
+                                             : op_result + operand;
+          }
+        }
+        evaluation.result += op_result;
+        return evaluation;
+      });
+  uint64_t result = 0;
+  for (const auto &chunk : chunks) {
+    // sanity check, like `part_2()`
+    if (chunk.empty_col) {
+      throw std::runtime_error("Parsed operand is zero at column " +
+                               std::to_string(*chunk.empty_col));
+    }
+    result += chunk.result;
+  }
+  return result;
+}
+
+struct Answers {
+  uint64_t part_1 = 0;
+  uint64_t part_2 = 0;
+};
+
+// Both parts in one sweep over the columns of the worksheet, left to right,
+// reading every line forward in lockstep (rather than one forward scan of
+// the bytes, which would only see the operators at the end). The operand
+// rows' numbers (part 1) and the columns' numbers (part 2) of a problem are
+// accumulated as its columns go by, and folded into the answers when the
+// next operator comes up.
+// Time: O(rows * cols), Space: O(rows) for one number per operand row,
+// instead of O(operators)
+Answers solve_single_pass(const auto &operand_lines,
+                          std::string_view operator_line) {
+  const std::vector<std::string_view> lines(operand_lines.begin(),
+                                            operand_lines.end());
+  for (const auto &line : lines) {
+    if (line.size() != operator_line.size()) {
+      throw std::runtime_error("Operand line length does not match operator "
+                               "line length");
+    }
+  }
+  const auto is_operator = [](char c) { return c == '+' || c == '*'; };
+
+  struct RowOperand {
+    uint64_t value = 0;
+    bool has_digits = false;
+    // a blank followed the digits, so any more would be a second number
+    bool ended = false;
+  };
+  std::vector<RowOperand> row_operands(lines.size());
+  Answers answers;
+  bool is_multiply = false;
+  uint64_t column_result = 0;
+  const auto finish_problem = [&] {
+    uint64_t row_result = is_multiply;
+    for (auto &operand : row_operands) {
+      if (!operand.has_digits) {
+        throw std::runtime_error(
+            "Operand row size does not match number of operators");
+      }
+      row_result = is_multiply ? row_result * operand.value
+                               : row_result + operand.value;
+      operand = RowOperand{};
+    }
+    answers.part_1 += row_result;
+    answers.part_2 += column_result;
+  };
+
+  for (size_t col = 0; col < operator_line.size(); ++col) {
+    const char op = operator_line[col];
+    if (is_operator(op)) {
+      if (col > 0) {
+        finish_problem();
+      }
+      is_multiply = (op == '*');
+      column_result = is_multiply;
+    } else if (op != ' ' || col == 0) {
+      throw std::runtime_error("Invalid operator: " + std::string(1, op));
+    }
+    // the blank column before the next operator separates the problems
+    if (col + 1 < operator_line.size() && is_operator(operator_line[col + 1])) {
+      continue;
+    }
+    uint64_t operand = 0;
+    for (size_t row = 0; row < lines.size(); ++row) {
+      auto &row_operand = row_operands[row];
+      const auto digit = static_cast<uint64_t>(lines[row][col] - '0');
+      if (digit < 10) {
+        // like `part_1()`, which would see an extra number in the row
+        if (row_operand.ended) {
+          throw std::runtime_error(
+              "Operand row size does not match number of operators");
+        }
+        operand = operand * 10 + digit;
+        row_operand.value = row_operand.value * 10 + digit;
+        row_operand.has_digits = true;
+      } else {
+        row_operand.ended = row_operand.has_digits;
+      }
+    }
+    // sanity check, like `part_2()`
+    if (operand == 0) {
+      throw std::runtime_error("Parsed operand is zero at column " +
+                               std::to_string(col));
+    }
+    column_result =
+        is_multiply ? column_result * operand : column_result + operand;
+  }
+  if (!operator_line.empty()) {
+    finish_problem();
+  }
+  return answers;
+}
+
+auto parse(std::string_view text) {
+  std::vector<std::string_view> input_lines;
+  for (const auto line : aoc::lines(text)) {
     input_lines.push_back(line);
   }
   // at least 2 lines
   if (input_lines.size() < 2) {
-    std::cerr << "Insufficient input data. There should be at least one line "
-                 "of operands and one line of operators."
-              << std::endl;
-    return 1;
+    throw std::runtime_error(
+        "Insufficient input data. There should be at least one line of "
+        "operands and one line of operators.");
   }
+  return input_lines;
+}
+
+int run_day(aoc::Runner &runner) {
+  const auto &input_lines = runner.parse(parse);
   const auto &operator_line = input_lines.back();
   const auto &operand_lines =
       input_lines | std::views::take(input_lines.size() - 1);
-  std::cout << "Part 1: " << part_1(operand_lines, operator_line) << std::endl;
-  std::cout << "Part 2: " << part_2(operand_lines, operator_line) << std::endl;
-  return 0;
+  // one sweep over the worksheet computes both parts
+  const auto &answers = runner.derive("solve_single_pass", [&] {
+    return solve_single_pass(operand_lines, operator_line);
+  });
+  runner.part(1, "part_1",
+              [&] { return part_1(operand_lines, operator_line); });
+  runner.part(2, "part_2",
+              [&] { return part_2(operand_lines, operator_line); });
+  runner.part(2, "part_2_transposed",
+              [&] { return part_2_transposed(operand_lines, operator_line); });
+  runner.part(1, "single_pass", [&] { return answers.part_1; });
+  runner.part(2, "single_pass", [&] { return answers.part_2; });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 6, run_day)
@@ -0,0 +1,29 @@
+// Generates a SIZE x SIZE manifold: the first row holds the start 'S' in the
+// middle, and every other row below has splitters ('^'). No two splitters in
+// a row are neighbours, as the solver requires.
+#include "common/generate.hpp"
+#include <algorithm>
+#include <string>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr double splitter_density = 0.3;
+    aoc::Random random{args.seed};
+    const auto size = std::max<uint64_t>(args.size, 3);
+    std::string row(size, '.');
+    row[size / 2] = 'S';
+    out << std::string_view(row) << '\n';
+    for (uint64_t r = 1; r < size; ++r) {
+      row.assign(size, '.');
+      if (r % 2 == 0) {
+        // keep the outermost columns free, like the real inputs
+        for (uint64_t c = 1; c + 1 < size; ++c) {
+          if (row[c - 1] != '^' && random.chance(splitter_density)) {
+            row[c] = '^';
+          }
+        }
+      }
+      out << std::string_view(row) << '\n';
+    }
+  });
+}
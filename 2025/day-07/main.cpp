@@ -1,22 +1,37 @@
+#include "common/arena.hpp"
+#include "common/grid.hpp"
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <iostream>
+#include <memory_resource>
 #include <numeric>
-#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
-auto part_1(const std::vector<std::vector<bool>> &manifold, auto start_pos) {
-  const auto cols = manifold[0].size();
+namespace {
+
+// The two rows of beams are allocated once and swapped, so the loop itself
+// doesn't allocate.
+auto part_1(const aoc::BitGrid &manifold, auto start_pos) {
+  const auto cols = manifold.cols();
+  aoc::Arena arena;
   int split_count = 0;
-  std::vector<bool> beams(cols, false);
+  std::pmr::vector<bool> beams(cols, false, &arena);
+  decltype(beams) new_beams(cols, false, &arena);
   beams[start_pos] = true;
-  for (const auto &row : manifold) {
-    decltype(beams) new_beams(cols, false);
+  for (size_t row = 0; row < manifold.rows(); ++row) {
+    std::fill(new_beams.begin(), new_beams.end(), false);
     for (size_t col = 0; col < cols; ++col) {
       if (!beams[col]) {
         continue;
       }
-      if (!row[col]) { // vertical path continues
+      if (!manifold(row, col)) { // vertical path continues
         new_beams[col] = true;
       } else { // split
         if (col > 0) {
@@ -30,20 +45,23 @@ auto part_1(const std::vector<std::vector<bool>> &manifold, auto start_pos) {
     }
     std::swap(beams, new_beams);
   }
+  arena.report();
   return split_count;
 }
 
-auto part_2(const std::vector<std::vector<bool>> &manifold, auto start_pos) {
-  const auto cols = manifold[0].size();
-  std::vector<uint64_t> timelines(cols, 0);
+auto part_2(const aoc::BitGrid &manifold, auto start_pos) {
+  const auto cols = manifold.cols();
+  aoc::Arena arena;
+  std::pmr::vector<uint64_t> timelines(cols, 0, &arena);
+  decltype(timelines) new_timelines(cols, 0, &arena);
   timelines[start_pos] = 1;
-  for (const auto &row : manifold) {
-    decltype(timelines) new_timelines(cols, 0);
+  for (size_t row = 0; row < manifold.rows(); ++row) {
+    std::fill(new_timelines.begin(), new_timelines.end(), 0);
     for (size_t col = 0; col < cols; ++col) {
       if (timelines[col] == 0) {
         continue;
       }
-      if (!row[col]) { // vertical path continues
+      if (!manifold(row, col)) { // vertical path continues
         new_timelines[col] += timelines[col];
       } else { // split
         if (col > 0) {
@@ -56,45 +74,65 @@ auto part_2(const std::vector<std::vector<bool>> &manifold, auto start_pos) {
     }
     std::swap(timelines, new_timelines);
   }
+  arena.report();
   return std::reduce(timelines.cbegin(), timelines.cend());
 }
 
-int main() {
-  std::string line;
-  std::cin >> line;
+auto parse(std::string_view text) {
+  aoc::Scanner scanner{text};
   // find the starting point
-  const auto start_pos = line.find('S');
-  if (start_pos == std::string::npos) {
+  const auto start_pos = scanner.token().find('S');
+  if (start_pos == std::string_view::npos) {
     throw std::runtime_error("No starting point 'S' found in input");
   }
-  std::vector<std::vector<bool>> manifold;
-  while (std::cin >> line) {
-    manifold.emplace_back(
-        line | std::views::transform([](char c) { return c == '^'; }) |
-        std::ranges::to<std::vector<bool>>());
+  std::vector<std::string_view> lines;
+  while (!scanner.done()) {
+    lines.push_back(scanner.token());
   }
-  std::cout << "Start position: " << start_pos << std::endl;
   // sanity check: manifold should be a rectangle
-  const auto row_size = manifold[0].size();
-  for (const auto &row : manifold) {
-    if (row.size() != row_size) {
+  if (lines.empty()) {
+    throw std::runtime_error("Manifold has no rows");
+  }
+  for (const auto line : lines) {
+    if (line.size() != lines[0].size()) {
       throw std::runtime_error("Manifold rows are not the same size");
     }
   }
-  // also, there shouldn't be neighboring splits in the same row
-  for (const auto &row : manifold) {
-    for (size_t col = 1; col < row.size(); ++col) {
-      if (row[col] && row[col - 1]) {
+  aoc::BitGrid manifold(lines.size(), lines[0].size());
+  for (size_t row = 0; row < lines.size(); ++row) {
+    for (size_t col = 0; col < lines[row].size(); ++col) {
+      manifold.set(row, col, lines[row][col] == '^');
+    }
+  }
+  // also, there shouldn't be neighboring splits in the same row, which we
+  // check 64 columns at a time
+  for (size_t row = 0; row < manifold.rows(); ++row) {
+    const auto words = manifold.row_words(row);
+    uint64_t carry = 0; // the last column of the previous word
+    for (size_t i = 0; i < words.size(); ++i) {
+      // bit c is set if both column c - 1 and c are splits
+      const auto pairs = words[i] & ((words[i] << 1) | carry);
+      if (pairs != 0) {
         throw std::runtime_error(
             "Manifold has neighboring splits in the same row at column " +
-            std::to_string(col));
+            std::to_string(i * 64 + std::countr_zero(pairs)));
       }
+      carry = words[i] >> 63;
     }
   }
-  std::cout << "Manifold size: " << manifold.size() << " x "
-            << manifold[0].size() << std::endl;
-  std::cout << "Part 1: " << part_1(manifold, start_pos) << std::endl;
+  return std::pair{start_pos, manifold};
+}
 
-  std::cout << "Part 1: " << part_2(manifold, start_pos) << std::endl;
-  return 0;
+int run_day(aoc::Runner &runner) {
+  const auto &[start_pos, manifold] = runner.parse(parse);
+  aoc::count("start_position", start_pos);
+  aoc::count("rows", manifold.rows());
+  aoc::count("cols", manifold.cols());
+  runner.part(1, "part_1", [&] { return part_1(manifold, start_pos); });
+  runner.part(2, "part_2", [&] { return part_2(manifold, start_pos); });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 7, run_day)
@@ -0,0 +1,24 @@
+// Generates SIZE junction boxes "x,y,z" with coordinates in [0, 100000).
+// SIZE must be at least 500: the solver always makes 1000 connections, and
+// with fewer random boxes those often leave fewer than the 3 circuits part 1
+// multiplies (at 350 boxes, about 1 seed in 20 does).
+#include "common/generate.hpp"
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr int max_coordinate = 99'999;
+    constexpr uint64_t min_size = 500;
+    if (args.size < min_size) {
+      throw std::runtime_error("SIZE must be at least " +
+                               std::to_string(min_size));
+    }
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      out << random.between(0, max_coordinate) << ','
+          << random.between(0, max_coordinate) << ','
+          << random.between(0, max_coordinate) << '\n';
+    }
+  });
+}
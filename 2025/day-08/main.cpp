@@ -1,9 +1,16 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <queue>
 #include <vector>
 
+namespace {
+
 constexpr auto part_1_num_connections = 1000;
 constexpr auto part_1_top_k_circuits = 3;
 constexpr auto part_2_num_circuits = 1;
@@ -19,15 +26,14 @@ template <typename T> struct JBox {
     return os;
   }
 
-  // input operator for parsing
-  friend std::istream &operator>>(std::istream &is, JBox<T> &coord) {
+  // input format: x,y,z
+  static JBox<T> parse(aoc::Scanner &scanner) {
     constexpr auto delimiter = ',';
-    char delimiter1, delimiter2;
-    is >> coord.x >> delimiter1 >> coord.y >> delimiter2 >> coord.z;
-    if (delimiter1 != delimiter || delimiter2 != delimiter) {
-      is.setstate(std::ios::failbit);
-    }
-    return is;
+    JBox<T> coord;
+    coord.x = scanner.number<T>();
+    coord.y = scanner.expect(delimiter).number<T>();
+    coord.z = scanner.expect(delimiter).number<T>();
+    return coord;
   }
 
   // Eculidean distance squared to another junction box
@@ -154,14 +160,22 @@ auto part_2(const std::vector<JBoxInt> &junction_boxes) {
   throw std::runtime_error("Could not fully connect all junction boxes");
 }
 
-int main() {
-  std::vector<JBox<int64_t>> junction_boxes;
-  for (JBox<int64_t> coord; std::cin >> coord;) {
-    junction_boxes.push_back(coord);
+auto parse(std::string_view text) {
+  std::vector<JBoxInt> junction_boxes;
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    junction_boxes.push_back(JBoxInt::parse(scanner));
   }
-  std::cout << "Number of junction boxes: " << junction_boxes.size()
-            << std::endl;
-  std::cout << "Part 1: " << part_1(junction_boxes) << std::endl;
-  std::cout << "Part 2: " << part_2(junction_boxes) << std::endl;
-  return 0;
+  return junction_boxes;
+}
+
+int run_day(aoc::Runner &runner) {
+  const auto &junction_boxes = runner.parse(parse);
+  aoc::count("junction_boxes", junction_boxes.size());
+  runner.part(1, "part_1", [&] { return part_1(junction_boxes); });
+  runner.part(2, "part_2", [&] { return part_2(junction_boxes); });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 8, run_day)
@@ -0,0 +1,51 @@
+// Generates a simple rectilinear polygon with SIZE red tiles as vertices
+// (rounded up to a multiple of 4). The polygon is a row of SIZE / 4 adjacent
+// columns, each spanning a random height range that contains the middle row,
+// so neighbouring columns always overlap and the outline never crosses itself.
+// Consecutive vertices share a row or a column, as the solver requires.
+#include "common/generate.hpp"
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    const auto columns = std::max<uint64_t>((args.size + 3) / 4, 1);
+    const auto max_x = std::max<uint64_t>(100'000, 4 * columns);
+    constexpr int64_t max_y = 100'000, mid_y = max_y / 2;
+    aoc::Random random{args.seed};
+    // distinct, sorted column boundaries
+    std::set<int64_t> unique_xs;
+    while (unique_xs.size() < columns + 1) {
+      unique_xs.insert(random.between<int64_t>(0, max_x));
+    }
+    const std::vector<int64_t> xs(unique_xs.begin(), unique_xs.end());
+    // top and bottom of each column, never equal to the neighbour's so that
+    // there are no collinear vertices
+    std::vector<int64_t> tops(columns), bottoms(columns);
+    for (uint64_t i = 0; i < columns; ++i) {
+      do {
+        tops[i] = mid_y + random.between<int64_t>(1, mid_y - 1);
+      } while (i > 0 && tops[i] == tops[i - 1]);
+      do {
+        bottoms[i] = mid_y - random.between<int64_t>(1, mid_y - 1);
+      } while (i > 0 && bottoms[i] == bottoms[i - 1]);
+    }
+    const auto emit = [&](int64_t x, int64_t y) {
+      out << x << ',' << y << '\n';
+    };
+    // clockwise: along the tops from left to right...
+    for (uint64_t i = 0; i < columns; ++i) {
+      emit(xs[i], tops[i]);
+      emit(xs[i + 1], tops[i]);
+    }
+    // ...then along the bottoms from right to left
+    emit(xs[columns], bottoms[columns - 1]);
+    for (auto i = columns - 1; i > 0; --i) {
+      emit(xs[i], bottoms[i]);
+      emit(xs[i], bottoms[i - 1]);
+    }
+    emit(xs[0], bottoms[0]);
+  });
+}
@@ -1,11 +1,19 @@
+#include "common/grid.hpp"
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <queue>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+namespace {
+
 template <std::signed_integral T> struct Tile {
   using UnsignedT = std::make_unsigned_t<T>;
   T x;
@@ -17,15 +25,13 @@ template <std::signed_integral T> struct Tile {
     return os;
   }
 
-  // input operator for parsing
-  friend std::istream &operator>>(std::istream &is, Tile<T> &coord) {
+  // input format: x,y
+  static Tile<T> parse(aoc::Scanner &scanner) {
     constexpr auto delimiter = ',';
-    char delimiter1;
-    is >> coord.x >> delimiter1 >> coord.y;
-    if (delimiter1 != delimiter) {
-      is.setstate(std::ios::failbit);
-    }
-    return is;
+    Tile<T> coord;
+    coord.x = scanner.number<T>();
+    coord.y = scanner.expect(delimiter).number<T>();
+    return coord;
   }
 
   UnsignedT rectangle_area_to(const Tile<T> &other) const {
@@ -59,27 +65,27 @@ private:
   }
 
 private:
-  const std::vector<int64_t> compressed_values;
+  std::vector<int64_t> compressed_values;
 
 public:
   CompressedValues(const std::vector<int64_t> &raw_values)
       : compressed_values(compress(raw_values)) {}
 
-  // Compress a raw value to its 1-based index in the compressed values.
+  // Compress a raw value to its index in the compressed values.
   size_t compress(int64_t value) const {
     auto it = std::lower_bound(compressed_values.begin(),
                                compressed_values.end(), value);
     if (it == compressed_values.end() || *it != value) {
       throw std::out_of_range("Value not found in compressed values.");
     }
-    return std::distance(compressed_values.begin(), it) + 1;
+    return std::distance(compressed_values.begin(), it);
   }
 
   int64_t decompress(size_t index) const {
-    if (index > compressed_values.size()) {
+    if (index >= compressed_values.size()) {
       throw std::out_of_range("Index out of range for compressed values.");
     }
-    return compressed_values[index - 1];
+    return compressed_values[index];
   }
 
   size_t size() const { return compressed_values.size(); }
@@ -88,7 +94,16 @@ public:
 // we consider edge tiles to be inside the polygon
 enum class CompressedTileType { UNKNOWN, INSIDE, OUTSIDE };
 
-auto part_2(const std::vector<Tile<int64_t>> &tiles) {
+// The polygon on the compressed grid, which only depends on the tiles and so
+// is derived once and shared, see `run_day()`.
+struct CompressedPolygon {
+  CompressedValues x, y;
+  // prefix_sums(x + 1, y + 1) = area of all inside tiles in rectangle (0,0) to
+  // (x,y) (inclusive)
+  aoc::Grid<uint64_t> prefix_sums;
+};
+
+CompressedPolygon compress_polygon(const std::vector<Tile<int64_t>> &tiles) {
   // 1. Collect all x and y values from the tiles, and compress them.
   std::vector<int64_t> x_values, y_values;
   for (const auto &tile : tiles) {
@@ -99,14 +114,12 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
   // 2. Create a 2D grid using the compressed values
   const auto compressed_width = compressed_x.size(),
              compressed_height = compressed_y.size();
-  std::cout << "Compressed grid size: " << compressed_width << " x "
-            << compressed_height << std::endl;
-  // 2 extra rows and columns as padding, so that we can flood fill the outside
-  // area
-  std::vector<std::vector<CompressedTileType>> grid(
-      compressed_width + 2,
-      std::vector<CompressedTileType>(compressed_height + 2,
-                                      CompressedTileType::UNKNOWN));
+  aoc::count("compressed_width", compressed_width);
+  aoc::count("compressed_height", compressed_height);
+  // indexed by (x, y), padded by one tile on every side so that we can flood
+  // fill the outside area
+  aoc::Grid<CompressedTileType> grid(compressed_width, compressed_height,
+                                     CompressedTileType::UNKNOWN, 1);
   // 3. Draw the polygon edges on the grid
   const auto n = tiles.size();
   for (size_t i = 0; i < n; ++i) {
@@ -121,25 +134,25 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
       const auto min_y = std::min(start_y, end_y);
       const auto max_y = std::max(start_y, end_y);
       for (size_t y = min_y; y <= max_y; ++y) {
-        grid[start_x][y] = CompressedTileType::INSIDE;
+        grid(start_x, y) = CompressedTileType::INSIDE;
       }
     } else if (start_y == end_y) {
       // horizontal line
       const auto min_x = std::min(start_x, end_x);
       const auto max_x = std::max(start_x, end_x);
       for (size_t x = min_x; x <= max_x; ++x) {
-        grid[x][start_y] = CompressedTileType::INSIDE;
+        grid(x, start_y) = CompressedTileType::INSIDE;
       }
     } else {
       throw std::runtime_error(
           "Only horizontal and vertical lines are supported.");
     }
   }
-  // 4. Flood fill the outside area from (0,0)
-  std::queue<std::pair<size_t, size_t>> to_visit;
-  to_visit.push({0, 0});
-  grid[0][0] = CompressedTileType::OUTSIDE;
-  const std::vector<std::pair<int64_t, int64_t>> directions{
+  // 4. Flood fill the outside area from the padding corner (-1, -1)
+  std::queue<std::pair<ptrdiff_t, ptrdiff_t>> to_visit;
+  to_visit.push({-1, -1});
+  grid(-1, -1) = CompressedTileType::OUTSIDE;
+  const std::vector<std::pair<ptrdiff_t, ptrdiff_t>> directions{
       {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
   while (!to_visit.empty()) {
     const auto [x, y] = to_visit.front();
@@ -147,10 +160,9 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
     for (const auto &[dx, dy] : directions) {
       const auto nx = x + dx;
       const auto ny = y + dy;
-      // because we use unsigned indices, we only need to check the upper bounds
-      if (nx < compressed_width + 2 && ny < compressed_height + 2 &&
-          grid[nx][ny] == CompressedTileType::UNKNOWN) {
-        grid[nx][ny] = CompressedTileType::OUTSIDE;
+      if (grid.in_bounds(nx, ny) &&
+          grid(nx, ny) == CompressedTileType::UNKNOWN) {
+        grid(nx, ny) = CompressedTileType::OUTSIDE;
         to_visit.push({nx, ny});
       }
     }
@@ -158,10 +170,10 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
 
   // DEBUG: print the compressed grid
   // std::cout << "\nCompressed grid:" << std::endl;
-  // for (size_t y = 0; y < compressed_height + 2; ++y) {
-  //   for (size_t x = 0; x < compressed_width + 2; ++x) {
+  // for (ptrdiff_t y = -1; y <= ptrdiff_t(compressed_height); ++y) {
+  //   for (ptrdiff_t x = -1; x <= ptrdiff_t(compressed_width); ++x) {
   //     char c = '?';
-  //     switch (grid[x][y]) {
+  //     switch (grid(x, y)) {
   //     case CompressedTileType::UNKNOWN:
   //       c = '.';
   //       break;
@@ -177,21 +189,26 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
   //   std::cout << std::endl;
   // }
 
-  // 5. Calculate the prefix sums of inside tile areas in the compressed grid:
-  // prefix_sums[x + 1][y + 1] = area of all inside tiles in rectangle (0,0) to
-  // (x,y) (inclusive)
-  std::vector<std::vector<uint64_t>> prefix_sums(
-      compressed_width + 2, std::vector<uint64_t>(compressed_height + 2, 0u));
+  // 5. Calculate the prefix sums of inside tile areas in the compressed grid
+  aoc::Grid<uint64_t> prefix_sums(compressed_width + 1, compressed_height + 1);
   const auto is_compressed_tile_inside = [&](auto x, auto y) {
-    return grid[x][y] != CompressedTileType::OUTSIDE;
+    return grid(x, y) != CompressedTileType::OUTSIDE;
   };
-  for (size_t x = 1; x < compressed_width + 2; ++x) {
-    for (size_t y = 1; y < compressed_height + 2; ++y) {
-      prefix_sums[x][y] = prefix_sums[x - 1][y] + prefix_sums[x][y - 1] -
-                          prefix_sums[x - 1][y - 1] +
+  for (size_t x = 1; x <= compressed_width; ++x) {
+    for (size_t y = 1; y <= compressed_height; ++y) {
+      prefix_sums(x, y) = prefix_sums(x - 1, y) + prefix_sums(x, y - 1) -
+                          prefix_sums(x - 1, y - 1) +
                           is_compressed_tile_inside(x - 1, y - 1);
     }
   }
+  return CompressedPolygon{std::move(compressed_x), std::move(compressed_y),
+                           std::move(prefix_sums)};
+}
+
+auto part_2(const std::vector<Tile<int64_t>> &tiles,
+            const CompressedPolygon &polygon) {
+  const auto &[compressed_x, compressed_y, prefix_sums] = polygon;
+  const auto n = tiles.size();
   // 6. Finally, enumerate all possible rectangles and find the maximum area
   uint64_t max_area = 0;
   for (size_t i = 0; i < n; ++i) {
@@ -207,8 +224,8 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
       // the rectangle is inside iff its area equals to the number of inside
       // tiles in the compressed grid
       const auto compressed_inside_tile_count =
-          prefix_sums[x2 + 1][y2 + 1] + prefix_sums[x1][y1] -
-          prefix_sums[x1][y2 + 1] - prefix_sums[x2 + 1][y1];
+          prefix_sums(x2 + 1, y2 + 1) + prefix_sums(x1, y1) -
+          prefix_sums(x1, y2 + 1) - prefix_sums(x2 + 1, y1);
       const auto compressed_area = (x2 - x1 + 1) * (y2 - y1 + 1);
       if (compressed_inside_tile_count == compressed_area) {
         max_area = area;
@@ -218,12 +235,24 @@ auto part_2(const std::vector<Tile<int64_t>> &tiles) {
   return max_area;
 }
 
-int main() {
-  std::vector<Tile<int64_t>> tiles{
-      std::istream_iterator<Tile<int64_t>>(std::cin),
-      std::istream_iterator<Tile<int64_t>>()};
-  std::cout << "Number of red tiles: " << tiles.size() << std::endl;
-  std::cout << "Part 1: " << part_1_naive(tiles) << std::endl;
-  std::cout << "Part 2: " << part_2(tiles) << std::endl;
-  return 0;
+auto parse(std::string_view text) {
+  std::vector<Tile<int64_t>> tiles;
+  for (aoc::Scanner scanner{text}; !scanner.done();) {
+    tiles.push_back(Tile<int64_t>::parse(scanner));
+  }
+  return tiles;
 }
+
+int run_day(aoc::Runner &runner) {
+  const auto &tiles = runner.parse(parse);
+  aoc::count("red_tiles", tiles.size());
+  runner.part(1, "part_1_naive", [&] { return part_1_naive(tiles); });
+  const auto &polygon = runner.derive(
+      "compressed_polygon", [&] { return compress_polygon(tiles); });
+  runner.part(2, "part_2", [&] { return part_2(tiles, polygon); });
+  return runner.finish();
+}
+
+} // namespace
+
+AOC_MAIN(2025, 9, run_day)
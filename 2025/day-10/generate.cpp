@@ -0,0 +1,56 @@
+// Generates SIZE machines, one per line, e.g.
+//   [.##.] (3) (1,3) (2) (2,3) (0,2) (0,1) {3,5,4,7}
+// The target lights are the XOR of a random subset of the buttons and the
+// joltages are the sums of random button presses, so both parts always have a
+// solution.
+#include "common/generate.hpp"
+#include <vector>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr int min_lights = 4, max_lights = 10;
+    constexpr int min_buttons = 3, max_buttons = 13, max_presses = 30;
+    aoc::Random random{args.seed};
+    for (uint64_t i = 0; i < args.size; ++i) {
+      const auto num_lights = random.between(min_lights, max_lights);
+      const auto num_buttons = random.between(min_buttons, max_buttons);
+      std::vector<unsigned> buttons(num_buttons);
+      for (auto &button : buttons) {
+        while (button == 0) {
+          button = random.between(1u, (1u << num_lights) - 1);
+        }
+      }
+      unsigned lights = 0;
+      std::vector<unsigned> joltages(num_lights, 0);
+      for (const auto button : buttons) {
+        if (random.chance(0.5)) {
+          lights ^= button;
+        }
+        const auto presses = random.between(0, max_presses);
+        for (int light = 0; light < num_lights; ++light) {
+          joltages[light] += ((button >> light) & 1) * presses;
+        }
+      }
+      out << '[';
+      for (int light = 0; light < num_lights; ++light) {
+        out << (((lights >> light) & 1) ? '#' : '.');
+      }
+      out << ']';
+      for (const auto button : buttons) {
+        out << " (";
+        for (int light = 0, first = 1; light < num_lights; ++light) {
+          if ((button >> light) & 1) {
+            out << (first ? "" : ",") << light;
+            first = 0;
+          }
+        }
+        out << ')';
+      }
+      out << " {";
+      for (int light = 0; light < num_lights; ++light) {
+        out << (light == 0 ? "" : ",") << joltages[light];
+      }
+      out << "}\n";
+    }
+  });
+}
@@ -1,10 +1,18 @@
 #include "Highs.h"
+#include "common/arena.hpp"
+#include "common/input.hpp"
+#include "common/runner.hpp"
+#include <array>
 #include <bitset>
 #include <iostream>
-#include <sstream>
+#include <memory_resource>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+namespace {
+
 // there can be only up to 10 lights
 constexpr size_t max_light_num = 10;
 
@@ -12,21 +20,90 @@ using Lights = std::bitset<max_light_num>;
 using Button = std::bitset<max_light_num>;
 using Joltages = std::array<uint, max_light_num>;
 
+// one machine per input line:
+// [.##.] (3) (1,3) (2) (2,3) (0,2) (0,1) {3,5,4,7}
+struct Machine {
+  Lights lights{0};
+  std::vector<Button> buttons;
+  Joltages joltages;
+
+  static Machine parse(std::string_view line) {
+    aoc::Scanner scanner{line};
+    Machine machine;
+    char c = scanner.next();
+    if (c != '[') {
+      throw std::runtime_error("Expect '[' but got " + std::string(1, c));
+    }
+    // read the target indictor lights
+    for (size_t i = 0; i < max_light_num + 1; ++i) {
+      c = scanner.next();
+      if (c == '.') {
+        machine.lights[i] = false;
+      } else if (c == '#') {
+        machine.lights[i] = true;
+      } else if (c == ']') {
+        break;
+      } else {
+        throw std::runtime_error(
+            "Got some unexpected character while reading the lights: " +
+            std::string(1, c));
+      }
+    }
+    // read the buttons
+    while ((c = scanner.next()) == '(') {
+      Button button{0};
+      for (;;) {
+        button[scanner.number<uint>()] = true;
+        c = scanner.next();
+        if (c == ',') {
+          // read on
+        } else if (c == ')') {
+          break;
+        } else {
+          throw std::runtime_error(
+              "Got some unexpected character while reading the buttons: " +
+              std::string(1, c));
+        }
+      }
+      machine.buttons.push_back(button);
+    }
+    // read the joltage requirements
+    if (c != '{') {
+      throw std::runtime_error("Expect '{' but got " + std::string(1, c));
+    }
+    for (size_t i = 0; i < max_light_num; ++i) {
+      machine.joltages[i] = scanner.number<uint>();
+      c = scanner.next();
+      if (c == ',') {
+        // read on
+      } else if (c == '}') {
+        break;
+      } else {
+        throw std::runtime_error(
+            "Got some unexpected character while reading the joltages: " +
+            std::string(1, c));
+      }
+    }
+    return machine;
+  }
+};
+
 // BFS
 // Time: O(N), where N is the number of possible states (2 ** light_num)
 // Space: O(N)
-auto part_1(const Lights target_lights, const std::vector<Button> &buttons) {
+// The two BFS levels are allocated from `arena` and reused for every level.
+auto part_1(const Lights target_lights, const std::vector<Button> &buttons,
+            aoc::Arena &arena) {
   if (target_lights == 0) {
     return 0u;
   }
   std::bitset<(1 << max_light_num)> visited{0};
   visited.set(0);
-  std::vector<Lights> current{
-      0,
-  };
+  std::pmr::vector<Lights> current(1, Lights{0}, &arena);
+  decltype(current) next(&arena);
   uint operations = 0;
   while (!current.empty()) {
-    decltype(current) next;
+    next.clear();
     ++operations;
     for (const auto state : current) {
       for (const auto button : buttons) {
@@ -46,7 +123,7 @@ auto part_1(const Lights target_lights, const std::vector<Button> &buttons) {
 }
 
 auto part_2(const Joltages &target_joltages,
-            const std::vector<Button> &buttons) {
+            const std::vector<Button> &buttons, aoc::Arena &arena) {
 
   // model this as an ILP problem:
   // Objective:
@@ -68,11 +145,15 @@ auto part_2(const Joltages &target_joltages,
 
   // 2. Define Constraints (Rows)
   // We add equations one by one.
+  // Unzip the C++ pair into C-style arrays for the API, reusing the arrays
+  // (from the arena) for every row
+  std::pmr::vector<int> indices(&arena);
+  std::pmr::vector<double> values(&arena);
+  indices.reserve(buttons.size());
+  values.reserve(buttons.size());
   for (size_t j = 0; j < max_light_num; ++j) {
-    // Unzip the C++ pair into C-style arrays for the API
-    std::vector<int> indices;
-    std::vector<double> values;
-
+    indices.clear();
+    values.clear();
     for (size_t i = 0; i < buttons.size(); ++i) {
       if (buttons[i][j]) {
         indices.push_back(i);
@@ -97,73 +178,56 @@ auto part_2(const Joltages &target_joltages,
   return highs.getInfo().objective_function_value;
 }
 
-int main() {
+// Both parts in one pass over the machines, without storing them.
+auto stream_parts(aoc::LineReader &lines) {
+  aoc::Arena arena;
   uint light_operations{0}, joltage_operations{0};
-  for (std::string line; std::getline(std::cin, line);) {
-    std::istringstream iss{line};
-    Lights lights{0};
-    std::vector<Button> buttons;
-    char c;
-    iss >> c;
-    if (c != '[') {
-      throw std::runtime_error("Expect '[' but got " + std::string(1, c));
-    }
-    // read the target indictor lights
-    for (size_t i = 0; i < max_light_num + 1; ++i) {
-      iss >> c;
-      if (c == '.') {
-        lights[i] = false;
-      } else if (c == '#') {
-        lights[i] = true;
-      } else if (c == ']') {
-        break;
-      } else {
-        throw std::runtime_error(
-            "Got some unexpected character while reading the lights: " +
-            std::string(1, c));
-      }
-    }
-    // read the buttons
-    while (iss >> c && c == '(') {
-      Button button{0};
-      uint d;
-      while (iss >> d >> c) {
-        button[d] = true;
-        if (c == ',') {
-          // read on
-        } else if (c == ')') {
-          break;
-        } else {
-          throw std::runtime_error(
-              "Got some unexpected character while reading the buttons: " +
-              std::string(1, c));
-        }
-      }
-      buttons.push_back(button);
-    }
-    // read the joltage requirements
-    if (c != '{') {
-      throw std::runtime_error("Expect '{' but got " + std::string(1, c));
+  for (const auto line : lines) {
+    const auto machine = Machine::parse(line);
+    light_operations += part_1(machine.lights, machine.buttons, arena);
+    joltage_operations += part_2(machine.joltages, machine.buttons, arena);
+    arena.release();
+  }
+  return std::pair{light_operations, joltage_operations};
+}
+
+auto parse(std::string_view text) {
+  std::vector<Machine> machines;
+  for (const auto line : aoc::lines(text)) {
+    machines.push_back(Machine::parse(line));
+  }
+  return machines;
+}
+
+int run_day(aoc::Runner &runner) {
+  if (runner.streaming()) {
+    runner.stream("stream", stream_parts);
+    return runner.finish();
+  }
+  const auto &machines = runner.parse(parse);
+  // one arena per part, shared by all machines; HiGHS allocates on its own
+  runner.part(1, "part_1", [&] {
+    aoc::Arena arena;
+    uint light_operations{0};
+    for (const auto &machine : machines) {
+      light_operations += part_1(machine.lights, machine.buttons, arena);
     }
-    Joltages joltages;
-    uint d;
-    for (size_t i = 0; i < max_light_num; ++i) {
-      iss >> d >> c;
-      joltages[i] = d;
-      if (c == ',') {
-        // read on
-      } else if (c == '}') {
-        break;
-      } else {
-        throw std::runtime_error(
-            "Got some unexpected character while reading the joltages: " +
-            std::string(1, c));
-      }
+    arena.report();
+    return light_operations;
+  });
+  runner.part(2, "part_2", [&] {
+    aoc::Arena arena;
+    uint joltage_operations{0};
+    for (const auto &machine : machines) {
+      joltage_operations += part_2(machine.joltages, machine.buttons, arena);
     }
-    light_operations += part_1(lights, buttons);
-    joltage_operations += part_2(joltages, buttons);
-  }
-  std::cout << "Part 1: " << light_operations << std::endl;
-  std::cout << "Part 1: " << joltage_operations << std::endl;
-  return 0;
+    arena.report();
+    return joltage_operations;
+  });
+  runner.stream("stream", stream_parts);
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 10, run_day)
@@ -0,0 +1,144 @@
+// Generates a DAG with about SIZE edges, one "from: to1 to2 ..." line per node
+// with outgoing edges, in random order.
+//
+// The paths all run along a thin backbone: "svr", "fft", "you", "dac" and
+// "out", in that order, with 40 backbone nodes between each and the next.
+// Every backbone node links to the next one, and at most 8 of each stretch
+// also skip over it, which doubles the paths through that stretch. So part
+// 1 has at most 2^16 paths, few enough to enumerate one by one, and part 2
+// at most 2^32. Every other node is in a dead-end tree hanging off the
+// backbone before "you", which only adds edges for the solvers to read.
+//
+// Names have 3 letters like the puzzle's as long as there are few enough
+// nodes, and more letters otherwise.
+#include "common/generate.hpp"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr uint64_t stretch = 40, max_skips = 8;
+    constexpr double skip_chance = 0.15, backbone_root_chance = 0.05;
+    // ranks of the special nodes: the backbone comes first, then the trees
+    const std::array<std::string, 5> special_names{"svr", "fft", "you", "dac",
+                                                   "out"};
+    const std::array<uint64_t, 5> special_ranks{0, stretch, 2 * stretch,
+                                                3 * stretch, 4 * stretch};
+    const uint64_t backbone = special_ranks.back() + 1;
+    const uint64_t num_nodes = backbone + args.size;
+    aoc::Random random{args.seed};
+
+    // Everyone else gets a name by scrambling their rank with a bijection on
+    // [0, 26^length). With 3 letters, names that clash with a special name
+    // are redirected to the (unused) names of the special ranks.
+    uint64_t length = 3, name_space = 26 * 26 * 26;
+    while (name_space < num_nodes + special_names.size()) {
+      ++length;
+      name_space *= 26;
+    }
+    const auto scramble = [&](uint64_t rank) {
+      // 7919 is prime and doesn't divide 26^length, so this is a bijection
+      return (rank * 7919 + 12345) % name_space;
+    };
+    const auto spell = [&](uint64_t index) {
+      std::string name(length, 'a');
+      for (auto &c : name | std::views::reverse) {
+        c = static_cast<char>('a' + index % 26);
+        index /= 26;
+      }
+      return name;
+    };
+    std::vector<std::string> clashing, freed;
+    if (length == 3) {
+      for (size_t i = 0; i < special_names.size(); ++i) {
+        const auto own = spell(scramble(special_ranks[i]));
+        if (std::find(special_names.begin(), special_names.end(), own) ==
+            special_names.end()) {
+          freed.push_back(own);
+        }
+        if (std::find_if(special_ranks.begin(), special_ranks.end(),
+                         [&](uint64_t rank) {
+                           return spell(scramble(rank)) == special_names[i];
+                         }) == special_ranks.end()) {
+          clashing.push_back(special_names[i]);
+        }
+      }
+    }
+    const auto name_of = [&](uint64_t rank) {
+      for (size_t i = 0; i < special_ranks.size(); ++i) {
+        if (rank == special_ranks[i]) {
+          return special_names[i];
+        }
+      }
+      auto name = spell(scramble(rank));
+      const auto clash = std::find(clashing.begin(), clashing.end(), name);
+      if (clash != clashing.end()) {
+        name = freed[clash - clashing.begin()];
+      }
+      return name;
+    };
+
+    // the edges as lists of targets per node, in one buffer
+    std::vector<uint64_t> parents(num_nodes - backbone);
+    std::vector<uint64_t> degrees(num_nodes);
+    std::vector<bool> skips(backbone);
+    for (uint64_t node = 0; node + 1 < backbone; ++node) {
+      degrees[node] = 1;
+    }
+    for (size_t i = 1; i < special_ranks.size(); ++i) {
+      uint64_t count = 0;
+      for (auto from = special_ranks[i - 1];
+           from + 2 <= special_ranks[i] && count < max_skips; ++from) {
+        // overlapping skips would multiply the paths faster, so there are
+        // none
+        if ((from == 0 || !skips[from - 1]) && random.chance(skip_chance)) {
+          skips[from] = true;
+          ++degrees[from];
+          ++count;
+        }
+      }
+    }
+    // a tree node hangs off the backbone before "you" or off an earlier
+    // tree node, so no backbone node after it reaches the trees
+    for (uint64_t node = backbone; node < num_nodes; ++node) {
+      auto &parent = parents[node - backbone];
+      parent = node == backbone || random.chance(backbone_root_chance)
+                   ? random.between<uint64_t>(0, special_ranks[2] - 1)
+                   : random.between(backbone, node - 1);
+      ++degrees[parent];
+    }
+    std::vector<uint64_t> offsets(num_nodes + 1);
+    std::partial_sum(degrees.begin(), degrees.end(), offsets.begin() + 1);
+    std::vector<uint64_t> targets(offsets.back());
+    std::vector<uint64_t> filled(offsets.begin(), offsets.end() - 1);
+    for (uint64_t node = 0; node + 1 < backbone; ++node) {
+      targets[filled[node]++] = node + 1;
+      if (skips[node]) {
+        targets[filled[node]++] = node + 2;
+      }
+    }
+    for (uint64_t node = backbone; node < num_nodes; ++node) {
+      targets[filled[parents[node - backbone]]++] = node;
+    }
+
+    // every node with edges gets a line, in random order
+    std::vector<uint64_t> sources;
+    for (uint64_t node = 0; node < num_nodes; ++node) {
+      if (offsets[node + 1] > offsets[node]) {
+        sources.push_back(node);
+      }
+    }
+    std::shuffle(sources.begin(), sources.end(), random.raw());
+    for (const auto from : sources) {
+      out << std::string_view(name_of(from)) << ':';
+      for (auto i = offsets[from]; i < offsets[from + 1]; ++i) {
+        out << ' ' << std::string_view(name_of(targets[i]));
+      }
+      out << '\n';
+    }
+  });
+}
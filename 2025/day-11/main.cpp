@@ -1,20 +1,40 @@
+#include "common/arena.hpp"
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <queue>
-#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace {
+
+// the puzzle only has 3-letter names, but generated inputs with millions of
+// nodes need a few more letters
+constexpr size_t max_name_length = 7;
+
 class Node {
-  char name[4]; // always 3-letter names
+  char name[max_name_length + 1];
 public:
   friend struct std::hash<Node>; // allow std::hash to access private members
-  explicit Node(const char *n) {
-    std::strncpy(name, n, 3);
-    name[3] = '\0';
+  explicit Node(std::string_view n) {
+    if (n.size() > max_name_length) {
+      throw std::runtime_error("Node name too long: " + std::string(n));
+    }
+    std::memcpy(name, n.data(), n.size());
+    name[n.size()] = '\0';
   }
 
   explicit Node() : name{""} {}
@@ -23,12 +43,7 @@ public:
     return std::strcmp(name, other.name) == 0;
   }
 
-  friend std::istream &operator>>(std::istream &is, Node &node) {
-    // read 3 non-whitespace characters
-    is >> node.name[0] >> node.name[1] >> node.name[2];
-    node.name[3] = '\0';
-    return is;
-  }
+  static Node parse(aoc::Scanner &scanner) { return Node(scanner.word()); }
 
   friend std::ostream &operator<<(std::ostream &os, const Node &node) {
     os << node.name;
@@ -36,23 +51,31 @@ public:
   }
 };
 
+} // namespace
+
 template <> struct std::hash<Node> {
   auto operator()(const Node &node) const {
-    return std::hash<std::string_view>()(std::string_view(node.name, 3));
+    return std::hash<std::string_view>()(std::string_view(node.name));
   }
 };
 
+namespace {
+
 const Node part_1_start_node{"you"}, part_2_start_node{"svr"}, end_node{"out"},
     part_2_fft_node{"fft"}, part_2_dac_node{"dac"};
 
+// node -> the nodes it has edges to. Its hash nodes all live in the arena
+// that `parse()` returns along with it.
+using Graph = std::pmr::unordered_map<Node, std::pmr::unordered_set<Node>>;
+
 // Naive solution: just DFS to traverse all paths from "you" to "out".
 // This is quite naive as we may visit the same node multiple times and repeat
 // work, but it works for the input size.
-auto part_1_naive(
-    const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
+auto part_1_naive(const Graph &graph) {
   // there can't be cycles, otherwise there may be infinite paths to "out"
   uint64_t paths_to_out = 0;
-  std::vector<Node> to_visit{part_1_start_node};
+  aoc::Arena arena;
+  std::pmr::vector<Node> to_visit({part_1_start_node}, &arena);
   while (!to_visit.empty()) {
     const auto current = to_visit.back();
     to_visit.pop_back();
@@ -67,16 +90,17 @@ auto part_1_naive(
       to_visit.push_back(neighbor);
     }
   }
+  arena.report();
   return paths_to_out;
 }
 
 // DFS with memoization to avoid repeated work.
 // Time: O(V + E)
 // Space: O(V) for memo AND recursion stack.
-auto part_1_dfs_memo(
-    const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
+auto part_1_dfs_memo(const Graph &graph) {
+  aoc::Arena arena;
   // memoization map: node -> number of paths from node to "out"
-  std::unordered_map<Node, uint64_t> memo;
+  std::pmr::unordered_map<Node, uint64_t> memo(&arena);
 
   std::function<uint64_t(const Node &)> dfs =
       [&](const Node &node) -> uint64_t {
@@ -95,19 +119,26 @@ auto part_1_dfs_memo(
     memo[node] = total_paths;
     return total_paths;
   };
-  return dfs(part_1_start_node);
+  const auto paths = dfs(part_1_start_node);
+  arena.report();
+  return paths;
 }
 
-auto topological_sort(
-    const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
-  std::unordered_map<Node, size_t> in_degrees;
+// Every node reachable by an edge, in an order where edges only go forward.
+// The scratch containers live in an arena of their own; the order itself is
+// derived once and shared by the parts, see `run_day()`.
+std::vector<Node> topological_sort(const Graph &graph) {
+  aoc::Arena arena;
+  std::pmr::memory_resource *memory = &arena;
+  std::pmr::unordered_map<Node, size_t> in_degrees(memory);
   for (const auto &[from, neighbors] : graph) {
     in_degrees.try_emplace(from, 0);
     for (const auto &to : neighbors) {
       ++in_degrees[to];
     }
   }
-  std::queue<Node> free_nodes{};
+  std::queue<Node, std::pmr::deque<Node>> free_nodes{
+      std::pmr::deque<Node>(memory)};
   for (const auto &[node, degree] : in_degrees) {
     if (degree == 0) {
       free_nodes.push(node);
@@ -129,14 +160,15 @@ auto topological_sort(
       }
     }
   }
+  arena.report();
   return topological_order;
 }
 
-auto count_paths_between(
-    const std::unordered_map<Node, std::unordered_set<Node>> &graph,
-    const std::vector<Node> &topological_order, const Node &start,
-    const Node &end) {
-  std::unordered_map<Node, uint64_t> path_counts;
+auto count_paths_between(const Graph &graph,
+                         const std::vector<Node> &topological_order,
+                         const Node &start, const Node &end,
+                         std::pmr::memory_resource *memory) {
+  std::pmr::unordered_map<Node, uint64_t> path_counts(memory);
   path_counts[start] = 1u;
   for (const auto &node : topological_order) {
     if (node == end) { // early termination
@@ -152,15 +184,17 @@ auto count_paths_between(
 }
 
 // Topological sort + DP solution.
-auto part_1_topological_sort(
-    const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
-  const auto topological_order = topological_sort(graph);
-  return count_paths_between(graph, topological_order, part_1_start_node,
-                             end_node);
+auto part_1_topological_sort(const Graph &graph,
+                             const std::vector<Node> &topological_order) {
+  aoc::Arena arena;
+  const auto paths = count_paths_between(graph, topological_order,
+                                         part_1_start_node, end_node, &arena);
+  arena.report();
+  return paths;
 }
 
-auto part_2(const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
-  const auto topological_order = topological_sort(graph);
+auto part_2(const Graph &graph, const std::vector<Node> &topological_order) {
+  aoc::Arena arena;
   // Check whether fft or dac comes first - there can't be both a path from
   // fft to dac and a path from dac to fft, otherwise there would be a cycle.
   auto first_node = part_2_fft_node, second_node = part_2_dac_node;
@@ -169,40 +203,58 @@ auto part_2(const std::unordered_map<Node, std::unordered_set<Node>> &graph) {
                                         topological_order.end(), second_node)) {
     std::swap(first_node, second_node);
   }
-  return count_paths_between(graph, topological_order, part_2_start_node,
-                             first_node) *
-         count_paths_between(graph, topological_order, first_node,
-                             second_node) *
-         count_paths_between(graph, topological_order, second_node, end_node);
+  const auto paths = count_paths_between(graph, topological_order,
+                                         part_2_start_node, first_node,
+                                         &arena) *
+                     count_paths_between(graph, topological_order, first_node,
+                                         second_node, &arena) *
+                     count_paths_between(graph, topological_order,
+                                         second_node, end_node, &arena);
+  arena.report();
+  return paths;
 }
 
-int main() {
-  std::unordered_map<Node, std::unordered_set<Node>> graph;
-  for (std::string line; std::getline(std::cin, line);) {
-    std::istringstream iss(line);
-    Node from;
-    iss >> from;
-    char separator;
-    iss >> separator;
+// Returns the arena along with the graph, which must not outlive it.
+auto parse(std::string_view text) {
+  auto arena = std::make_unique<aoc::Arena>();
+  Graph graph(arena.get());
+  for (const auto line : aoc::lines(text)) {
+    aoc::Scanner scanner{line};
+    const auto from = Node::parse(scanner);
+    const auto separator = scanner.next();
     if (separator != ':') {
       throw std::runtime_error("Expected ':' but got" +
                                std::string(1, separator));
     }
-    std::unordered_set<Node> to_nodes;
-    for (Node to; iss >> to;) {
-      to_nodes.insert(to);
+    // fill the node's set in place rather than building and copying one
+    auto &to_nodes = graph[from];
+    to_nodes.clear();
+    while (!scanner.done()) {
+      to_nodes.insert(Node::parse(scanner));
     }
-    graph[from] = to_nodes;
   }
-  std::cout << "Number of nodes with outgoing edges: " << graph.size()
-            << std::endl;
+  arena->report();
+  return std::pair{std::move(arena), std::move(graph)};
+}
+
+int run_day(aoc::Runner &runner) {
+  const auto &[arena, graph] = runner.parse(parse);
+  aoc::count("nodes_with_outgoing_edges", graph.size());
   const auto num_edges = std::accumulate(
       graph.begin(), graph.end(), 0u,
       [](auto sum, const auto &pair) { return sum + pair.second.size(); });
-  std::cout << "Number of edges: " << num_edges << std::endl;
-  std::cout << "Part 1: " << part_1_naive(graph) << std::endl;
-  std::cout << "Part 1: " << part_1_dfs_memo(graph) << std::endl;
-  std::cout << "Part 1: " << part_1_topological_sort(graph) << std::endl;
-  std::cout << "Part 2: " << part_2(graph) << std::endl;
-  return 0;
+  aoc::count("edges", num_edges);
+  runner.part(1, "part_1_naive", [&] { return part_1_naive(graph); });
+  runner.part(1, "part_1_dfs_memo", [&] { return part_1_dfs_memo(graph); });
+  const auto &topological_order = runner.derive(
+      "topological_order", [&] { return topological_sort(graph); });
+  runner.part(1, "part_1_topological_sort", [&] {
+    return part_1_topological_sort(graph, topological_order);
+  });
+  runner.part(2, "part_2", [&] { return part_2(graph, topological_order); });
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 11, run_day)
@@ -0,0 +1,45 @@
+// Generates the 6 shapes followed by SIZE regions. Every region is decidable
+// by the solver's two shortcuts: either all presents fit into separate 3x3
+// blocks, or there are more present pixels than the region has cells.
+#include "common/generate.hpp"
+#include <array>
+#include <numeric>
+#include <string_view>
+
+int main(int argc, char **argv) {
+  return aoc::generate(argc, argv, [](const auto &args, aoc::Writer &out) {
+    constexpr std::array<std::string_view, 6> shapes{
+        "###\n##.\n##.", "###\n##.\n.##", ".##\n###\n##.",
+        "##.\n###\n##.", "###\n#..\n###", "###\n.#.\n###"};
+    constexpr std::array<unsigned, 6> shape_pixels{7, 7, 7, 7, 7, 7};
+    constexpr unsigned min_side = 10, max_side = 50;
+    aoc::Random random{args.seed};
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      out << i << ":\n" << shapes[i] << "\n\n";
+    }
+    for (uint64_t i = 0; i < args.size; ++i) {
+      const auto width = random.between(min_side, max_side);
+      const auto height = random.between(min_side, max_side);
+      std::array<unsigned, shapes.size()> counts{};
+      if (random.chance(0.5)) {
+        // fits: at most one present per 3x3 block
+        const auto blocks = (width / 3) * (height / 3);
+        for (auto n = random.between(blocks / 2, blocks); n > 0; --n) {
+          ++counts[random.between<size_t>(0, shapes.size() - 1)];
+        }
+      } else {
+        // doesn't fit: more pixels than cells
+        for (unsigned pixels = 0; pixels <= width * height;) {
+          const auto shape = random.between<size_t>(0, shapes.size() - 1);
+          ++counts[shape];
+          pixels += shape_pixels[shape];
+        }
+      }
+      out << width << 'x' << height << ':';
+      for (const auto count : counts) {
+        out << ' ' << count;
+      }
+      out << '\n';
+    }
+  });
+}
@@ -1,10 +1,18 @@
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/runner.hpp"
+#include <array>
+#include <cstdint>
 #include <iostream>
-#include <istream>
-#include <iterator>
 #include <numeric>
-#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+namespace {
+
 constexpr uint shape_size = 3;
 constexpr uint num_shapes = 6;
 
@@ -12,12 +20,12 @@ struct Shape {
   uint num_pixels;
   // this problem is just prank - we don't actually need to store the shape, but
   // just the number of pixels
-  friend std::istream &operator>>(std::istream &is, Shape &shape) {
+  // `next_line` yields the following input line each time it's called
+  static Shape parse(auto &&next_line) {
     uint num_pixels{0};
-    std::string line;
     uint line_count = 0;
     while (line_count < shape_size) {
-      std::getline(is, line);
+      const std::string_view line = next_line();
       if (line.empty()) {
         continue; // skip empty lines
       }
@@ -33,13 +41,14 @@ struct Shape {
       }
       ++line_count;
     }
-    shape.num_pixels = num_pixels;
-    return is;
+    return Shape{.num_pixels = num_pixels};
   }
 };
 
+using ShapeCounts = std::array<uint, num_shapes>;
+
 auto part_1(const std::vector<Shape> &shapes, uint width, uint height,
-            const std::vector<uint> &shape_counts) {
+            const ShapeCounts &shape_counts) {
   // If the region is large enough to fit all the shapes into their 3x3 blocks,
   // it definitely can fit
   const auto num_blocks = (width / shape_size) * (height / shape_size);
@@ -62,12 +71,55 @@ auto part_1(const std::vector<Shape> &shapes, uint width, uint height,
       "Cannot determine whether the shapes can fit in the region.");
 }
 
-int main() {
+// one region per line, e.g. "12x5: 1 0 1 0 2 2"
+struct Region {
+  uint width;
+  uint height;
+  ShapeCounts shape_counts;
+
+  static Region parse(std::string_view line) {
+    aoc::Scanner scanner{line};
+    const auto width = scanner.number<uint>();
+    auto separator = scanner.next();
+    if (separator != 'x') {
+      throw std::runtime_error("Expected 'x' but got " +
+                               std::string(1, separator));
+    }
+    const auto height = scanner.number<uint>();
+    separator = scanner.next();
+    if (separator != ':') {
+      throw std::runtime_error("Expected ':' but got " +
+                               std::string(1, separator));
+    }
+    ShapeCounts shape_counts;
+    size_t num_counts = 0;
+    for (; !scanner.done(); ++num_counts) {
+      const auto count = scanner.number<uint>();
+      if (num_counts < num_shapes) {
+        shape_counts[num_counts] = count;
+      }
+    }
+    if (num_counts != num_shapes) {
+      throw std::runtime_error("Expected " + std::to_string(num_shapes) +
+                               " shape counts but got " +
+                               std::to_string(num_counts));
+    }
+    return Region{width, height, shape_counts};
+  }
+};
+
+// The shapes at the start of the input. `next_line` yields the following
+// input line each time it's called.
+auto parse_shapes(auto &&next_line) {
   std::vector<Shape> shapes;
   for (uint i = 0; i < num_shapes; ++i) {
-    uint index;
-    char colon;
-    std::cin >> index >> colon;
+    auto header = next_line();
+    while (header.empty()) {
+      header = next_line();
+    }
+    aoc::Scanner scanner{header};
+    const auto index = scanner.number<uint>();
+    const auto colon = scanner.next();
     if (colon != ':') {
       throw std::runtime_error("Expected ':' but got " + std::string(1, colon));
     }
@@ -75,42 +127,72 @@ int main() {
       throw std::runtime_error("Expected shape index " + std::to_string(i) +
                                " but got " + std::to_string(index));
     }
-    Shape shape;
-    std::cin >> shape;
-    shapes.push_back(shape);
-  }
-  // print shapes info
-  for (uint i = 0; i < num_shapes; ++i) {
-    std::cout << "Shape " << i << ": " << shapes[i].num_pixels << " pixels"
-              << std::endl;
+    shapes.push_back(Shape::parse(next_line));
   }
-  uint64_t can_fit_count = 0;
-  for (std::string line; std::getline(std::cin, line);) {
+  return shapes;
+}
+
+// The only part in one pass over the regions, without storing them.
+auto stream_parts(aoc::LineReader &lines) {
+  const auto shapes = parse_shapes([&] {
+    const auto line = lines.next();
+    if (!line) {
+      throw std::runtime_error("Unexpected end of input");
+    }
+    return *line;
+  });
+  uint64_t can_fit_count = 0, regions = 0;
+  for (const auto line : lines) {
     if (line.empty()) {
       continue; // skip empty lines
     }
-    std::istringstream iss(line);
-    char separator;
-    uint width, height;
-    iss >> width >> separator >> height;
-    if (separator != 'x') {
-      throw std::runtime_error("Expected 'x' but got " +
-                               std::string(1, separator));
-    }
-    iss >> separator;
-    if (separator != ':') {
-      throw std::runtime_error("Expected ':' but got " +
-                               std::string(1, separator));
+    const auto [width, height, shape_counts] = Region::parse(line);
+    can_fit_count += part_1(shapes, width, height, shape_counts);
+    ++regions;
+  }
+  aoc::count("regions", regions);
+  return can_fit_count;
+}
+
+auto parse(std::string_view text) {
+  auto line = aoc::lines(text).begin();
+  const auto shapes = parse_shapes([&] {
+    if (line == std::default_sentinel) {
+      throw std::runtime_error("Unexpected end of input");
     }
-    std::vector<uint> shape_counts{std::istream_iterator<uint>(iss),
-                                   std::istream_iterator<uint>()};
-    if (shape_counts.size() != num_shapes) {
-      throw std::runtime_error("Expected " + std::to_string(num_shapes) +
-                               " shape counts but got " +
-                               std::to_string(shape_counts.size()));
+    return *line++;
+  });
+  std::vector<Region> regions;
+  for (; line != std::default_sentinel; ++line) {
+    if ((*line).empty()) {
+      continue; // skip empty lines
     }
-    can_fit_count += part_1(shapes, width, height, shape_counts);
+    regions.push_back(Region::parse(*line));
+  }
+  return std::pair{shapes, regions};
+}
+
+int run_day(aoc::Runner &runner) {
+  if (runner.streaming()) {
+    runner.stream("stream", stream_parts);
+    return runner.finish();
+  }
+  const auto &[shapes, regions] = runner.parse(parse);
+  for (uint i = 0; i < num_shapes; ++i) {
+    aoc::count("shape_" + std::to_string(i) + "_pixels", shapes[i].num_pixels);
   }
-  std::cout << "Part 1: " << can_fit_count << std::endl;
-  return 0;
+  aoc::count("regions", regions.size());
+  runner.part(1, "part_1", [&] {
+    uint64_t can_fit_count = 0;
+    for (const auto &[width, height, shape_counts] : regions) {
+      can_fit_count += part_1(shapes, width, height, shape_counts);
+    }
+    return can_fit_count;
+  });
+  runner.stream("stream", stream_parts);
+  return runner.finish();
 }
+
+} // namespace
+
+AOC_MAIN(2025, 12, run_day)
@@ -0,0 +1,174 @@
+// Links every day of a year into one executable and runs them concurrently:
+//   ./all.out [--jobs=N] [--input=NAME] [--metrics-fd=N] [DAY...]
+// Each day reads YEAR/day-DD/NAME (input.txt by default), parses it and runs
+// every variant of every part as tasks on a shared pool of N worker threads
+// (one per hardware thread by default). Without DAYs, every linked day runs.
+//
+// The answers are printed in day order once everything is done, followed by
+// the total wall-clock time. With --metrics-fd=N (or AOC_METRICS_FD=N), every
+// day's metrics are written to file descriptor N, one JSON document per line.
+//
+// The days are compiled with -DAOC_ALL_DAYS, which turns their `AOC_MAIN`
+// into a registration; see `make run-all`.
+#include "common/input.hpp"
+#include "common/runner.hpp"
+#include "common/tasks.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using wall_clock = std::chrono::steady_clock;
+
+struct AllDaysOptions {
+  unsigned jobs = 0;
+  std::string input_name = "input.txt";
+  int metrics_fd = -1;
+  std::vector<int> days;
+
+  static AllDaysOptions parse(int argc, char **argv) {
+    AllDaysOptions options;
+    if (const auto *fd = std::getenv("AOC_METRICS_FD"); fd && *fd) {
+      options.metrics_fd = aoc::to_int<int>(fd);
+    }
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      if (arg.starts_with("--jobs=")) {
+        options.jobs = aoc::to_int<unsigned>(arg.substr(7));
+      } else if (arg.starts_with("--input=")) {
+        options.input_name = arg.substr(8);
+      } else if (arg.starts_with("--metrics-fd=")) {
+        options.metrics_fd = aoc::to_int<int>(arg.substr(13));
+      } else if (arg.starts_with("--")) {
+        throw std::runtime_error("Unknown option: " + std::string(arg));
+      } else {
+        options.days.push_back(aoc::to_int<int>(arg));
+      }
+    }
+    return options;
+  }
+};
+
+// One day's run: its runner (which holds the buffered answers) and outcome.
+struct DayRun {
+  const aoc::RegisteredDay *day = nullptr;
+  std::string input_path;
+  std::unique_ptr<aoc::Runner> runner;
+  int exit_code = 1;
+  std::string error;
+  double wall_seconds = 0;
+};
+
+std::string day_name(aoc::DayId id) {
+  std::ostringstream oss;
+  oss << id.year << " Day " << std::setw(2) << std::setfill('0') << id.day;
+  return oss.str();
+}
+
+std::string input_path(aoc::DayId id, std::string_view input_name) {
+  std::ostringstream oss;
+  oss << id.year << "/day-" << std::setw(2) << std::setfill('0') << id.day
+      << '/' << input_name;
+  return oss.str();
+}
+
+void run_one(DayRun &run, aoc::TaskPool &pool) {
+  const auto start = wall_clock::now();
+  try {
+    aoc::Options options;
+    options.input_path = run.input_path.c_str();
+    run.runner = std::make_unique<aoc::Runner>(run.day->id, options, &pool);
+    run.exit_code = run.day->run_day(*run.runner);
+  } catch (const std::exception &e) {
+    run.error = e.what();
+    run.exit_code = 1;
+  }
+  run.wall_seconds =
+      std::chrono::duration<double>(wall_clock::now() - start).count();
+}
+
+int run_all(int argc, char **argv) {
+  const auto options = AllDaysOptions::parse(argc, argv);
+  auto days = aoc::registered_days();
+  std::sort(days.begin(), days.end(), [](const auto &a, const auto &b) {
+    return std::pair{a.id.year, a.id.day} < std::pair{b.id.year, b.id.day};
+  });
+  for (const auto day : options.days) {
+    if (std::none_of(days.cbegin(), days.cend(),
+                     [&](const auto &d) { return d.id.day == day; })) {
+      throw std::runtime_error("Day " + std::to_string(day) +
+                               " isn't linked into this runner");
+    }
+  }
+
+  // the pool must outlive the runners, which wait for their tasks
+  aoc::TaskPool pool{options.jobs};
+  std::vector<DayRun> runs;
+  for (const auto &day : days) {
+    if (options.days.empty() ||
+        std::ranges::find(options.days, day.id.day) != options.days.end()) {
+      auto &run = runs.emplace_back();
+      run.day = &day;
+      run.input_path = input_path(day.id, options.input_name);
+    }
+  }
+
+  // Each day is driven by its own thread, which mostly just waits for the
+  // day's tasks; the actual work is spread over the pool.
+  const auto start = wall_clock::now();
+  {
+    std::vector<std::jthread> drivers;
+    drivers.reserve(runs.size());
+    for (auto &run : runs) {
+      drivers.emplace_back([&run, &pool] { run_one(run, pool); });
+    }
+  }
+  const auto total_seconds =
+      std::chrono::duration<double>(wall_clock::now() - start).count();
+
+  int exit_code = 0;
+  double busy_seconds = 0;
+  for (const auto &run : runs) {
+    std::cout << "--- " << day_name(run.day->id) << " ("
+              << aoc::format_seconds(run.wall_seconds) << ") ---\n";
+    if (run.runner) {
+      std::cout << run.runner->output() << std::flush;
+      std::cerr << run.runner->errors() << std::flush;
+      busy_seconds += run.runner->busy_seconds();
+      if (options.metrics_fd >= 0) {
+        run.runner->write_metrics(options.metrics_fd);
+      }
+    }
+    if (!run.error.empty()) {
+      std::cerr << "Error: " << run.error << std::endl;
+    }
+    exit_code = std::max(exit_code, run.exit_code);
+  }
+  std::cout << "--- " << runs.size() << " days in "
+            << aoc::format_seconds(total_seconds) << " on " << pool.size()
+            << " threads (" << aoc::format_seconds(busy_seconds)
+            << " of work) ---" << std::endl;
+  return exit_code;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    return run_all(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
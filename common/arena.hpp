@@ -0,0 +1,119 @@
+#pragma once
+
+#include "common/metrics.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+
+#include <sys/mman.h>
+
+namespace aoc {
+
+namespace detail {
+
+// Hands out the big chunks an `Arena` carves its allocations from: either
+// from the heap, or straight from mmap with transparent huge pages requested,
+// which saves TLB misses on large arenas.
+class ChunkResource final : public std::pmr::memory_resource {
+private:
+  static constexpr size_t huge_page_size = size_t{2} << 20;
+
+  bool huge_pages;
+  size_t chunks = 0;
+  size_t bytes = 0;
+
+  static size_t mapped_size(size_t n) {
+    return (n + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+
+  void *do_allocate(size_t n, size_t alignment) override {
+    ++chunks;
+    bytes += n;
+    if (!huge_pages) {
+      return ::operator new(n, std::align_val_t{alignment});
+    }
+    void *addr = mmap(nullptr, mapped_size(n), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    madvise(addr, mapped_size(n), MADV_HUGEPAGE);
+    return addr;
+  }
+
+  void do_deallocate(void *p, size_t n, size_t alignment) override {
+    if (!huge_pages) {
+      ::operator delete(p, n, std::align_val_t{alignment});
+    } else {
+      munmap(p, mapped_size(n));
+    }
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  explicit ChunkResource(bool huge_pages) : huge_pages(huge_pages) {}
+
+  size_t count() const { return chunks; }
+  size_t total_bytes() const { return bytes; }
+};
+
+} // namespace detail
+
+// A region that containers allocate from through std::pmr, e.g.
+//   aoc::Arena arena;
+//   std::pmr::vector<int> values(&arena);
+// Allocating is a pointer bump, deallocating does nothing, and everything is
+// released at once when the arena is destroyed. Memory is requested from the
+// system in geometrically growing chunks, so a part that allocates a lot
+// only pays for a handful of real allocations.
+//
+// Not thread-safe: use one arena per part (or per thread). With
+// AOC_HUGE_PAGES=1 in the environment, arenas are backed by huge pages.
+class Arena final : public std::pmr::memory_resource {
+private:
+  detail::ChunkResource chunks;
+  std::pmr::monotonic_buffer_resource buffer;
+  size_t allocations = 0;
+
+  void *do_allocate(size_t n, size_t alignment) override {
+    ++allocations;
+    return buffer.allocate(n, alignment);
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  static bool huge_pages_by_default() {
+    const auto *value = std::getenv("AOC_HUGE_PAGES");
+    return value && std::string_view(value) != "0";
+  }
+
+  explicit Arena(size_t initial_bytes = size_t{64} << 10,
+                 bool huge_pages = huge_pages_by_default())
+      : chunks(huge_pages), buffer(initial_bytes, &chunks) {}
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  // Free everything allocated so far at once, e.g. between independent
+  // records of a streamed input.
+  void release() { buffer.release(); }
+
+  // Report how many allocations the arena served, and how many (and how
+  // large) chunks it took from the system for that, for the current phase.
+  void report() const {
+    count("arena_allocations", allocations);
+    count("arena_chunks", chunks.count());
+    count("arena_bytes", chunks.total_bytes());
+  }
+};
+
+} // namespace aoc
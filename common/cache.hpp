@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace aoc {
+
+// A value in a `StateCache`, along with what it was computed from, which it
+// may point into (e.g. the input text that a parse result holds views of).
+template <typename T> struct CachedState {
+  std::shared_ptr<const void> source;
+  T value;
+};
+
+// Parse results and the state derived from them, shared between the requests
+// of a long-running process (see common/daemon.cpp), so that repeating a query
+// on the same input skips the work. The `Runner` keys entries by day, a hash
+// of the input and the phase; it also checks that a hit really was computed
+// from the same input.
+//
+// Thread-safe. Values are immutable and shared, so an evicted entry stays
+// valid for whoever still uses it. Beyond `capacity` entries, the least
+// recently used one is evicted.
+class StateCache {
+private:
+  struct Entry {
+    std::type_index type;
+    std::shared_ptr<const void> value;
+    uint64_t last_used;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<std::string, Entry> entries;
+  size_t capacity;
+  uint64_t clock = 0;
+  uint64_t hits = 0, misses = 0;
+
+  void evict() {
+    while (entries.size() > capacity) {
+      auto oldest = entries.begin();
+      for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->second.last_used < oldest->second.last_used) {
+          oldest = it;
+        }
+      }
+      entries.erase(oldest);
+    }
+  }
+
+public:
+  explicit StateCache(size_t capacity = 64) : capacity(capacity) {}
+  StateCache(const StateCache &) = delete;
+  StateCache &operator=(const StateCache &) = delete;
+
+  // nullptr unless there is an entry for `key` of type T
+  template <typename T> std::shared_ptr<const T> find(const std::string &key) {
+    std::lock_guard lock{mutex};
+    const auto it = entries.find(key);
+    if (it == entries.end() || it->second.type != typeid(T)) {
+      ++misses;
+      return nullptr;
+    }
+    ++hits;
+    it->second.last_used = ++clock;
+    return std::static_pointer_cast<const T>(it->second.value);
+  }
+
+  template <typename T>
+  void insert(const std::string &key, std::shared_ptr<const T> value) {
+    std::lock_guard lock{mutex};
+    entries.insert_or_assign(key, Entry{typeid(T), std::move(value), ++clock});
+    evict();
+  }
+
+  struct Stats {
+    size_t entries;
+    uint64_t hits, misses;
+  };
+
+  Stats stats() {
+    std::lock_guard lock{mutex};
+    return {entries.size(), hits, misses};
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,95 @@
+// Sends one request to the daemon (see common/daemon.cpp) and prints the
+// response as if the day had run here, exiting with the day's exit code:
+//   ./client.out [--socket=PATH] YEAR DAY [input.txt]
+//   ./client.out [--socket=PATH] --stats | --stop
+// An input path is sent as an absolute path for the daemon to read itself;
+// without one, the input is read from stdin and sent along.
+#include "common/input.hpp"
+#include "common/socket.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+int run_client(int argc, char **argv) {
+  std::string socket_path = aoc::default_socket_path();
+  std::optional<std::string> command;
+  std::vector<std::string_view> args;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg.starts_with("--socket=")) {
+      socket_path = arg.substr(9);
+    } else if (arg == "--stats" || arg == "--stop") {
+      command = std::string(arg.substr(2)) + "\n";
+    } else if (arg.starts_with("--")) {
+      throw std::runtime_error("Unknown option: " + std::string(arg));
+    } else {
+      args.push_back(arg);
+    }
+  }
+
+  // check the arguments and find the input before connecting, so that the
+  // daemon never sees a request we give up on
+  std::string request;
+  std::optional<aoc::Input> input;
+  if (command) {
+    request = *command;
+  } else if (args.size() == 2 || args.size() == 3) {
+    const auto year = aoc::to_int<int>(args[0]);
+    const auto day = aoc::to_int<int>(args[1]);
+    request = "run " + std::to_string(year) + " " + std::to_string(day) + " ";
+    if (args.size() == 3) {
+      // the daemon may well run in another directory
+      char *path = realpath(std::string(args[2]).c_str(), nullptr);
+      if (!path) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to find " + std::string(args[2]));
+      }
+      request += "path " + std::string(path) + "\n";
+      std::free(path);
+    } else {
+      input.emplace(STDIN_FILENO);
+      request += "text " + std::to_string(input->view().size()) + "\n";
+    }
+  } else {
+    throw std::runtime_error(
+        "Usage: client.out [--socket=PATH] YEAR DAY [input.txt] | --stats | "
+        "--stop");
+  }
+
+  auto connection = aoc::Connection::connect_to(socket_path);
+  connection.write_all(request);
+  if (input) {
+    connection.write_all(input->view());
+  }
+
+  const auto line = connection.read_line();
+  aoc::Scanner header{line};
+  const auto exit_code = header.number<int>();
+  const auto output_size = header.number<size_t>();
+  const auto errors_size = header.number<size_t>();
+  std::cout << connection.read_exact(output_size) << std::flush;
+  std::cerr << connection.read_exact(errors_size) << std::flush;
+  return exit_code;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    return run_client(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,225 @@
+// Links every day of a year into one long-running process that answers
+// requests on a Unix domain socket, so that repeated runs skip process start:
+//   ./daemon.out [--socket=PATH] [--jobs=N] [--cache=N]
+// The socket defaults to `aoc::default_socket_path()`. Requests are served
+// concurrently, with their parts running on a shared pool of N worker threads
+// (one per hardware thread by default).
+//
+// Parse results and derived state (see `Runner::derive()`) are kept in a
+// cache of up to N entries (64 by default), keyed by the content of the input,
+// so repeating a query on an unchanged input doesn't parse it again.
+//
+// Each connection carries one request, as a line followed by a payload:
+//   run YEAR DAY path PATH     - run a day on the input file at PATH
+//   run YEAR DAY text N        - run a day on the N bytes following the line
+//   stats                      - report what the cache holds
+//   stop                       - shut the daemon down
+// The response is a line "EXIT_CODE STDOUT_BYTES STDERR_BYTES", followed by
+// the output and errors of the run. See common/client.cpp for a client, and
+// `make daemon` and `make query`.
+#include "common/cache.hpp"
+#include "common/input.hpp"
+#include "common/runner.hpp"
+#include "common/socket.hpp"
+#include "common/tasks.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using wall_clock = std::chrono::steady_clock;
+
+struct DaemonOptions {
+  std::string socket_path = aoc::default_socket_path();
+  unsigned jobs = 0;
+  size_t cache_entries = 64;
+
+  static DaemonOptions parse(int argc, char **argv) {
+    DaemonOptions options;
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      if (arg.starts_with("--socket=")) {
+        options.socket_path = arg.substr(9);
+      } else if (arg.starts_with("--jobs=")) {
+        options.jobs = aoc::to_int<unsigned>(arg.substr(7));
+      } else if (arg.starts_with("--cache=")) {
+        options.cache_entries = aoc::to_int<size_t>(arg.substr(8));
+      } else {
+        throw std::runtime_error("Unknown option: " + std::string(arg));
+      }
+    }
+    return options;
+  }
+};
+
+struct Response {
+  int exit_code = 0;
+  std::string output;
+  std::string errors;
+};
+
+class Daemon {
+private:
+  aoc::TaskPool pool;
+  aoc::StateCache cache;
+  int listen_fd;
+  std::atomic<bool> stopping = false;
+
+  // One connection being served, on a thread of its own.
+  struct Handler {
+    std::atomic<bool> done = false;
+    std::jthread thread;
+  };
+  std::list<Handler> handlers;
+
+  Response run(aoc::Scanner &request, aoc::Connection &connection) {
+    const aoc::DayId id{request.number<int>(), request.number<int>()};
+    const auto &days = aoc::registered_days();
+    const auto day = std::find_if(days.cbegin(), days.cend(), [&](auto &d) {
+      return d.id.year == id.year && d.id.day == id.day;
+    });
+    const auto kind = request.word();
+    aoc::Options options;
+    std::string path, text;
+    if (kind == "path") {
+      request.skip_whitespace();
+      path = request.rest();
+      options.input_path = path.c_str();
+    } else if (kind == "text") {
+      text = connection.read_exact(request.number<size_t>());
+      options.input_text = text;
+    } else {
+      throw std::runtime_error("Expected 'path' or 'text' but got " +
+                               std::string(kind));
+    }
+    if (day == days.cend()) {
+      throw std::runtime_error("Day " + std::to_string(id.day) + " of " +
+                               std::to_string(id.year) +
+                               " isn't linked into this daemon");
+    }
+    Response response;
+    const auto start = wall_clock::now();
+    aoc::Runner runner{id, options, &pool, &cache};
+    try {
+      response.exit_code = day->run_day(runner);
+    } catch (const std::exception &e) {
+      response.exit_code = 1;
+      response.errors = std::string("Error: ") + e.what() + "\n";
+    }
+    response.output = runner.output();
+    response.errors = runner.errors() + response.errors;
+    const auto seconds =
+        std::chrono::duration<double>(wall_clock::now() - start).count();
+    std::clog << id.year << " day " << id.day << ": "
+              << aoc::format_seconds(seconds) << std::endl;
+    return response;
+  }
+
+  Response stats() {
+    const auto [entries, hits, misses] = cache.stats();
+    std::ostringstream oss;
+    oss << "cache entries: " << entries << "\ncache hits: " << hits
+        << "\ncache misses: " << misses << "\n";
+    return {0, oss.str(), ""};
+  }
+
+  void serve(aoc::Connection connection) {
+    Response response;
+    try {
+      const auto line = connection.read_line();
+      aoc::Scanner request{line};
+      const auto command = request.word();
+      if (command == "run") {
+        response = run(request, connection);
+      } else if (command == "stats") {
+        response = stats();
+      } else if (command == "stop") {
+        stopping = true;
+        // wakes up accept() in `serve_forever()`
+        shutdown(listen_fd, SHUT_RDWR);
+      } else {
+        throw std::runtime_error("Unknown command: " + std::string(command));
+      }
+    } catch (const std::exception &e) {
+      response = {1, "", std::string("Error: ") + e.what() + "\n"};
+    }
+    try {
+      connection.write_all(std::to_string(response.exit_code) + " " +
+                           std::to_string(response.output.size()) + " " +
+                           std::to_string(response.errors.size()) + "\n");
+      connection.write_all(response.output);
+      connection.write_all(response.errors);
+    } catch (const std::exception &e) {
+      std::clog << "Failed to respond: " << e.what() << std::endl;
+    }
+  }
+
+public:
+  explicit Daemon(const DaemonOptions &options)
+      : pool(options.jobs), cache(options.cache_entries),
+        listen_fd(aoc::listen_on(options.socket_path)) {}
+  Daemon(const Daemon &) = delete;
+  Daemon &operator=(const Daemon &) = delete;
+
+  // the handlers finish (and join) before the socket goes away
+  ~Daemon() {
+    handlers.clear();
+    close(listen_fd);
+  }
+
+  void serve_forever() {
+    while (!stopping) {
+      const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (stopping || errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to accept a connection");
+      }
+      handlers.remove_if([](const auto &h) { return h.done.load(); });
+      auto &handler = handlers.emplace_back();
+      handler.thread = std::jthread([this, fd, &handler] {
+        serve(aoc::Connection{fd});
+        handler.done = true;
+      });
+    }
+  }
+};
+
+int run_daemon(int argc, char **argv) {
+  const auto options = DaemonOptions::parse(argc, argv);
+  Daemon daemon{options};
+  std::clog << "Listening on " << options.socket_path << " with "
+            << aoc::registered_days().size() << " days" << std::endl;
+  daemon.serve_forever();
+  unlink(options.socket_path.c_str());
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    return run_daemon(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
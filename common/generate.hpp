@@ -0,0 +1,129 @@
+#pragma once
+
+#include "common/input.hpp"
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+// Command line of a day's input generator:
+//   ./generate.out SIZE [SEED] > input.txt
+// What SIZE counts (moves, ranges, rows, ...) is up to each day.
+struct GeneratorArgs {
+  uint64_t size;
+  uint64_t seed = 1;
+
+  static GeneratorArgs parse(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+      throw std::runtime_error(std::string("Usage: ") + argv[0] +
+                               " SIZE [SEED]");
+    }
+    GeneratorArgs args{.size = to_int<uint64_t>(argv[1])};
+    if (argc == 3) {
+      args.seed = to_int<uint64_t>(argv[2]);
+    }
+    return args;
+  }
+};
+
+// Buffered writer for large generated inputs, so we don't pay for iostream
+// formatting on every number.
+class Writer {
+private:
+  static constexpr size_t capacity = 1 << 20;
+  std::vector<char> buffer;
+  std::FILE *out;
+
+public:
+  explicit Writer(std::FILE *out = stdout) : out(out) {
+    buffer.reserve(capacity);
+  }
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+  ~Writer() { flush(); }
+
+  void flush() {
+    if (!buffer.empty()) {
+      std::fwrite(buffer.data(), 1, buffer.size(), out);
+      buffer.clear();
+    }
+  }
+
+  Writer &operator<<(char c) {
+    if (buffer.size() == capacity) {
+      flush();
+    }
+    buffer.push_back(c);
+    return *this;
+  }
+
+  Writer &operator<<(std::string_view text) {
+    if (buffer.size() + text.size() > capacity) {
+      flush();
+    }
+    if (text.size() > capacity) {
+      std::fwrite(text.data(), 1, text.size(), out);
+    } else {
+      buffer.insert(buffer.end(), text.begin(), text.end());
+    }
+    return *this;
+  }
+
+  template <std::integral T>
+    requires(!std::same_as<T, char>)
+  Writer &operator<<(T value) {
+    char digits[24];
+    const auto [end, ec] =
+        std::to_chars(digits, digits + sizeof(digits), value);
+    return *this << std::string_view(digits, end - digits);
+  }
+};
+
+// Small helpers around a seeded 64-bit Mersenne Twister.
+class Random {
+private:
+  std::mt19937_64 engine;
+
+public:
+  explicit Random(uint64_t seed) : engine(seed) {}
+
+  // uniform in [lo, hi]
+  template <std::integral T> T between(T lo, T hi) {
+    return std::uniform_int_distribution<T>(lo, hi)(engine);
+  }
+
+  bool chance(double probability) {
+    return std::bernoulli_distribution(probability)(engine);
+  }
+
+  template <typename T> const T &pick(const std::vector<T> &items) {
+    return items[between<size_t>(0, items.size() - 1)];
+  }
+
+  std::mt19937_64 &raw() { return engine; }
+};
+
+// Entry point for a generator: `int main(int argc, char **argv) { return
+// aoc::generate(argc, argv, write_input); }`, where
+// `write_input(const GeneratorArgs &, Writer &)` writes one input.
+template <typename F> int generate(int argc, char **argv, F &&write_input) {
+  try {
+    const auto args = GeneratorArgs::parse(argc, argv);
+    Writer writer;
+    write_input(args, writer);
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
+
+} // namespace aoc
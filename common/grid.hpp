@@ -0,0 +1,129 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// A rows x cols grid of T in one contiguous row-major buffer, for bytes,
+// enums, counters and the like (use `BitGrid` for booleans).
+//
+// The grid can be surrounded by `padding` extra cells on every side, holding
+// the fill value. Cells are addressed with signed indices, so with padding 1
+// `grid(r + dr, c + dc)` is valid for every cell and |dr|, |dc| <= 1, and
+// neighbour scans need no bounds checks.
+template <typename T> class Grid {
+private:
+  ptrdiff_t rows_, cols_, padding_, stride_;
+  std::vector<T> cells;
+
+  size_t index(ptrdiff_t r, ptrdiff_t c) const {
+    return (r + padding_) * stride_ + (c + padding_);
+  }
+
+public:
+  Grid(size_t rows, size_t cols, T fill = T{}, size_t padding = 0)
+      : rows_(rows), cols_(cols), padding_(padding),
+        stride_(cols + 2 * padding),
+        cells((rows + 2 * padding) * stride_, fill) {}
+
+  size_t rows() const { return rows_; }
+  size_t cols() const { return cols_; }
+  size_t padding() const { return padding_; }
+
+  // true if (r, c) is a cell or a padding cell
+  bool in_bounds(ptrdiff_t r, ptrdiff_t c) const {
+    return r >= -padding_ && r < rows_ + padding_ && c >= -padding_ &&
+           c < cols_ + padding_;
+  }
+
+  T &operator()(ptrdiff_t r, ptrdiff_t c) { return cells[index(r, c)]; }
+  const T &operator()(ptrdiff_t r, ptrdiff_t c) const {
+    return cells[index(r, c)];
+  }
+
+  // All cells, padding included, in one row-major span of `stride()` cells
+  // per row. (r, c) is at `flat_index(r, c)`, so (r + dr, c + dc) is at
+  // that plus dr * stride() + dc, for neighbour scans with fixed offsets.
+  std::span<T> flat() { return cells; }
+  std::span<const T> flat() const { return cells; }
+  size_t flat_index(ptrdiff_t r, ptrdiff_t c) const { return index(r, c); }
+  size_t stride() const { return stride_; }
+
+  // The cols cells of row r. The padding is contiguous with them, i.e.
+  // `row(r).data()[-1]` is the padding cell left of the row.
+  std::span<T> row(ptrdiff_t r) {
+    return {&cells[index(r, 0)], static_cast<size_t>(cols_)};
+  }
+  std::span<const T> row(ptrdiff_t r) const {
+    return {&cells[index(r, 0)], static_cast<size_t>(cols_)};
+  }
+};
+
+// A rows x cols grid of booleans, bit-packed into 64-bit words with every
+// row starting at a new word, so that rows can be processed a word (64
+// cells) at a time.
+//
+// Like `Grid`, it can be padded with `padding` false cells on every side.
+// Cell (r, c) is bit (c + padding) % 64 of word (c + padding) / 64 in
+// `row_words(r)`; the bits past the last padding cell are always 0.
+class BitGrid {
+private:
+  ptrdiff_t rows_, cols_, padding_, stride_;
+  std::vector<uint64_t> words;
+
+  uint64_t &word(ptrdiff_t r, ptrdiff_t c) {
+    return words[(r + padding_) * stride_ + (c + padding_) / 64];
+  }
+  uint64_t word(ptrdiff_t r, ptrdiff_t c) const {
+    return words[(r + padding_) * stride_ + (c + padding_) / 64];
+  }
+  static uint64_t bit(ptrdiff_t c, ptrdiff_t padding) {
+    return uint64_t{1} << ((c + padding) % 64);
+  }
+
+public:
+  BitGrid(size_t rows, size_t cols, size_t padding = 0)
+      : rows_(rows), cols_(cols), padding_(padding),
+        stride_((cols + 2 * padding + 63) / 64),
+        words((rows + 2 * padding) * stride_, 0) {}
+
+  size_t rows() const { return rows_; }
+  size_t cols() const { return cols_; }
+  size_t padding() const { return padding_; }
+  size_t words_per_row() const { return stride_; }
+
+  bool operator()(ptrdiff_t r, ptrdiff_t c) const {
+    return word(r, c) & bit(c, padding_);
+  }
+
+  void set(ptrdiff_t r, ptrdiff_t c, bool value = true) {
+    if (value) {
+      word(r, c) |= bit(c, padding_);
+    } else {
+      word(r, c) &= ~bit(c, padding_);
+    }
+  }
+
+  // Row r as words, padding included. Rows -padding to rows + padding - 1
+  // are valid, so that the padding rows can be read like any other.
+  std::span<uint64_t> row_words(ptrdiff_t r) {
+    return {&words[(r + padding_) * stride_], static_cast<size_t>(stride_)};
+  }
+  std::span<const uint64_t> row_words(ptrdiff_t r) const {
+    return {&words[(r + padding_) * stride_], static_cast<size_t>(stride_)};
+  }
+
+  // number of true cells
+  size_t count() const {
+    return std::transform_reduce(
+        words.begin(), words.end(), size_t{0}, std::plus<>(),
+        [](uint64_t w) { return static_cast<size_t>(std::popcount(w)); });
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aoc {
+
+// Parse a whole field as an integer, e.g. "123" -> 123. Leading/trailing
+// garbage is an error, unlike `std::cin >>`.
+template <std::integral T> T to_int(std::string_view field) {
+  T value{};
+  const auto [ptr, ec] =
+      std::from_chars(field.data(), field.data() + field.size(), value);
+  if (ec != std::errc{} || ptr != field.data() + field.size()) {
+    throw std::runtime_error("Invalid integer: '" + std::string(field) + "'");
+  }
+  return value;
+}
+
+// Lazily splits a string_view on a delimiter without copying. A trailing
+// delimiter doesn't produce an empty last field, so "a\nb\n" has two lines.
+// '\r' before a '\n' delimiter is dropped, so CRLF input works too.
+class Split {
+private:
+  std::string_view text;
+  char delimiter;
+
+public:
+  class iterator {
+  private:
+    std::string_view rest;
+    std::string_view field;
+    char delimiter = '\n';
+    bool done = true;
+
+    void advance() {
+      if (rest.empty()) {
+        done = true;
+        return;
+      }
+      const auto pos = rest.find(delimiter);
+      field = rest.substr(0, pos);
+      rest = (pos == std::string_view::npos) ? std::string_view{}
+                                             : rest.substr(pos + 1);
+      if (delimiter == '\n' && field.ends_with('\r')) {
+        field.remove_suffix(1);
+      }
+    }
+
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(std::string_view text, char delimiter)
+        : rest(text), delimiter(delimiter), done(false) {
+      advance();
+    }
+
+    std::string_view operator*() const { return field; }
+    iterator &operator++() {
+      advance();
+      return *this;
+    }
+    iterator operator++(int) {
+      auto copy = *this;
+      advance();
+      return copy;
+    }
+    bool operator==(std::default_sentinel_t) const { return done; }
+  };
+
+  Split(std::string_view text, char delimiter)
+      : text(text), delimiter(delimiter) {}
+
+  iterator begin() const { return {text, delimiter}; }
+  std::default_sentinel_t end() const { return {}; }
+};
+
+inline Split split(std::string_view text, char delimiter) {
+  return {text, delimiter};
+}
+
+inline Split lines(std::string_view text) { return {text, '\n'}; }
+
+// A forward-only cursor over some text, with roughly the same semantics as
+// chained `std::istream >>` extraction: reading a number, a token or an
+// expected character skips any leading whitespace (including newlines) first.
+// Numbers are parsed with `std::from_chars`, so no locale is involved.
+class Scanner {
+private:
+  std::string_view text;
+
+  static bool is_space(char c) {
+    return std::isspace(static_cast<unsigned char>(c));
+  }
+
+  [[noreturn]] void fail(const std::string &what) const {
+    throw std::runtime_error("Parse error: expected " + what + " at '" +
+                             std::string(text.substr(0, 20)) + "'");
+  }
+
+public:
+  explicit Scanner(std::string_view text) : text(text) {}
+
+  std::string_view rest() const { return text; }
+
+  // skip whitespace, including line breaks
+  Scanner &skip_whitespace() {
+    size_t i = 0;
+    while (i < text.size() && is_space(text[i])) {
+      ++i;
+    }
+    text.remove_prefix(i);
+    return *this;
+  }
+
+  // true if there's nothing but whitespace left
+  bool done() {
+    skip_whitespace();
+    return text.empty();
+  }
+
+  // peek at the next non-whitespace character, or '\0' at the end
+  char peek() {
+    skip_whitespace();
+    return text.empty() ? '\0' : text.front();
+  }
+
+  // consume `c` if it's the next non-whitespace character
+  bool consume(char c) {
+    if (peek() != c || text.empty()) {
+      return false;
+    }
+    text.remove_prefix(1);
+    return true;
+  }
+
+  Scanner &expect(char c) {
+    if (!consume(c)) {
+      fail(std::string("'") + c + "'");
+    }
+    return *this;
+  }
+
+  // next non-whitespace character, or '\0' at the end
+  char next() {
+    const auto c = peek();
+    if (!text.empty()) {
+      text.remove_prefix(1);
+    }
+    return c;
+  }
+
+  template <std::integral T> std::optional<T> try_number() {
+    skip_whitespace();
+    T value{};
+    const auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{}) {
+      return std::nullopt;
+    }
+    text.remove_prefix(ptr - text.data());
+    return value;
+  }
+
+  template <std::integral T> T number() {
+    if (const auto value = try_number<T>()) {
+      return *value;
+    }
+    fail("a number");
+  }
+
+  // next run of non-whitespace characters
+  std::string_view token() {
+    skip_whitespace();
+    size_t i = 0;
+    while (i < text.size() && !is_space(text[i])) {
+      ++i;
+    }
+    const auto result = text.substr(0, i);
+    text.remove_prefix(i);
+    return result;
+  }
+
+  // next run of letters and digits, e.g. "abc" out of "abc: def"
+  std::string_view word() {
+    skip_whitespace();
+    size_t i = 0;
+    while (i < text.size() &&
+           std::isalnum(static_cast<unsigned char>(text[i]))) {
+      ++i;
+    }
+    if (i == 0) {
+      fail("a word");
+    }
+    const auto result = text.substr(0, i);
+    text.remove_prefix(i);
+    return result;
+  }
+};
+
+// The whole puzzle input as one contiguous, read-only buffer. Regular files
+// are mmap'd, so nothing is copied; pipes and terminals fall back to a
+// buffered read. Text that is already in memory (e.g. sent to the daemon) can
+// be taken over as well.
+class Input {
+private:
+  const char *mapped = nullptr;
+  size_t mapped_size = 0;
+  std::string buffer;
+
+  void map_or_read(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        mapped = static_cast<const char *>(addr);
+        mapped_size = st.st_size;
+        return;
+      }
+    }
+    constexpr size_t chunk_size = 1 << 16;
+    for (;;) {
+      const auto old_size = buffer.size();
+      buffer.resize(old_size + chunk_size);
+      const auto n = read(fd, buffer.data() + old_size, chunk_size);
+      if (n < 0 && errno == EINTR) {
+        buffer.resize(old_size);
+        continue;
+      }
+      if (n < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to read input");
+      }
+      buffer.resize(old_size + n);
+      if (n == 0) {
+        break;
+      }
+    }
+  }
+
+public:
+  explicit Input(int fd) { map_or_read(fd); }
+
+  explicit Input(std::string text) : buffer(std::move(text)) {}
+
+  explicit Input(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              std::string("Failed to open ") + path);
+    }
+    map_or_read(fd);
+    close(fd); // the mapping stays valid after closing
+  }
+
+  Input(const Input &) = delete;
+  Input &operator=(const Input &) = delete;
+  Input(Input &&other) noexcept
+      : mapped(std::exchange(other.mapped, nullptr)),
+        mapped_size(std::exchange(other.mapped_size, 0)),
+        buffer(std::move(other.buffer)) {}
+  Input &operator=(Input &&) = delete;
+
+  ~Input() {
+    if (mapped) {
+      munmap(const_cast<char *>(mapped), mapped_size);
+    }
+  }
+
+  std::string_view view() const {
+    return mapped ? std::string_view(mapped, mapped_size)
+                  : std::string_view(buffer);
+  }
+
+  Split lines() const { return aoc::lines(view()); }
+  Scanner scanner() const { return Scanner(view()); }
+};
+
+// Reads lines one at a time, either from text already in memory or straight
+// from a file descriptor through a fixed-size buffer. In the latter case
+// memory stays constant however large the input is, e.g. a multi-GB
+// generated input piped in. Lines have the same semantics as `lines()`, and
+// each one is only valid until the next is read.
+class LineReader {
+private:
+  static constexpr size_t default_capacity = 1 << 20;
+
+  std::string_view text;
+  int fd = -1;
+  bool owns_fd = false;
+  bool eof = false;
+  std::string buffer;
+  size_t line_start = 0, filled = 0;
+  uint64_t bytes = 0;
+
+  std::string_view take(size_t pos, size_t next) {
+    auto line = std::string_view(buffer).substr(line_start, pos - line_start);
+    line_start = next;
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    return line;
+  }
+
+  void fill() {
+    // keep the unfinished line, and read more after it
+    std::memmove(buffer.data(), buffer.data() + line_start,
+                 filled - line_start);
+    filled -= line_start;
+    line_start = 0;
+    if (filled == buffer.size()) {
+      throw std::runtime_error("Input line longer than " +
+                               std::to_string(buffer.size()) + " bytes");
+    }
+    auto n = read(fd, buffer.data() + filled, buffer.size() - filled);
+    while (n < 0 && errno == EINTR) {
+      n = read(fd, buffer.data() + filled, buffer.size() - filled);
+    }
+    if (n < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Failed to read input");
+    }
+    eof = (n == 0);
+    filled += n;
+    bytes += n;
+  }
+
+public:
+  explicit LineReader(std::string_view text)
+      : text(text), eof(true), bytes(text.size()) {}
+
+  explicit LineReader(int fd, size_t capacity = default_capacity)
+      : fd(fd), buffer(capacity, '\0') {}
+
+  explicit LineReader(const char *path, size_t capacity = default_capacity)
+      : fd(open(path, O_RDONLY)), owns_fd(true), buffer(capacity, '\0') {
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              std::string("Failed to open ") + path);
+    }
+  }
+
+  LineReader(const LineReader &) = delete;
+  LineReader &operator=(const LineReader &) = delete;
+
+  ~LineReader() {
+    if (owns_fd) {
+      close(fd);
+    }
+  }
+
+  // the next line, or nothing at the end of the input
+  std::optional<std::string_view> next() {
+    if (fd < 0) {
+      if (text.empty()) {
+        return std::nullopt;
+      }
+      const auto pos = text.find('\n');
+      auto line = text.substr(0, pos);
+      text = (pos == std::string_view::npos) ? std::string_view{}
+                                             : text.substr(pos + 1);
+      if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+      }
+      return line;
+    }
+    for (;;) {
+      const auto pending = std::string_view(buffer).substr(
+          line_start, filled - line_start);
+      const auto pos = pending.find('\n');
+      if (pos != std::string_view::npos) {
+        return take(line_start + pos, line_start + pos + 1);
+      }
+      if (eof) {
+        if (line_start == filled) {
+          return std::nullopt;
+        }
+        return take(filled, filled);
+      }
+      fill();
+    }
+  }
+
+  // bytes of input consumed so far
+  uint64_t bytes_read() const { return bytes; }
+
+  class iterator {
+  private:
+    LineReader *reader = nullptr;
+    std::optional<std::string_view> line;
+
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(LineReader &reader)
+        : reader(&reader), line(reader.next()) {}
+
+    std::string_view operator*() const { return *line; }
+    iterator &operator++() {
+      line = reader->next();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return !line; }
+  };
+
+  iterator begin() { return iterator{*this}; }
+  std::default_sentinel_t end() { return {}; }
+};
+
+} // namespace aoc
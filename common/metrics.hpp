@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace aoc {
+
+// What we record about one phase (parse, or one variant of a part).
+struct PhaseMetrics {
+  std::string phase;
+  std::string variant;
+  double wall_seconds = 0;
+  // user + system time of the whole process (of the worker thread when days
+  // run concurrently)
+  double cpu_seconds = 0;
+  long peak_rss_bytes = 0; // high-water mark of the process so far
+  // only in bench mode, over all timed repetitions
+  std::optional<double> median_wall_seconds, p95_wall_seconds;
+  // item counts reported with `aoc::count()`, in order
+  std::vector<std::pair<std::string, uint64_t>> counts;
+};
+
+namespace detail {
+// The phase that `aoc::count()` reports into. Set by the Runner on the thread
+// running a phase, and left pointing at the last phase afterwards so that
+// counts reported right after parsing land in the parse phase.
+inline thread_local PhaseMetrics *current_phase = nullptr;
+// Whether counts are also echoed to stderr for humans.
+inline thread_local bool echo_counts = true;
+} // namespace detail
+
+// Report an item count (number of nodes, grid width, ...) for the current
+// phase. Reporting the same name again in the same phase overwrites it.
+inline void count(std::string_view name, uint64_t value) {
+  auto *phase = detail::current_phase;
+  if (phase) {
+    auto &counts = phase->counts;
+    auto it = counts.begin();
+    while (it != counts.end() && it->first != name) {
+      ++it;
+    }
+    if (it != counts.end()) {
+      if (it->second == value) {
+        return; // e.g. a repeated benchmark run
+      }
+      it->second = value;
+    } else {
+      counts.emplace_back(name, value);
+    }
+  }
+  if (detail::echo_counts) {
+    std::cerr << name << ": " << value << std::endl;
+  }
+}
+
+inline double process_cpu_seconds() {
+  timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+inline double thread_cpu_seconds() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+inline long peak_rss_bytes() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss * 1024L; // kilobytes on Linux
+}
+
+// All phases of one day, serialized as a single JSON document like
+//   {"year":2025,"day":9,"input_bytes":1234,"phases":[{"phase":"parse",
+//    "variant":"","wall_seconds":0.001,...,"counts":{"red_tiles":496}}]}
+class Metrics {
+private:
+  int year;
+  int day;
+  uint64_t input_bytes = 0;
+  // a deque, so that `detail::current_phase` stays valid as phases are added
+  std::deque<PhaseMetrics> phases;
+
+  static void write_string(std::ostream &os, std::string_view s) {
+    os << '"';
+    for (const auto c : s) {
+      if (c == '"' || c == '\\') {
+        os << '\\' << c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        os << "\\u00" << "0123456789abcdef"[c >> 4]
+           << "0123456789abcdef"[c & 0xf];
+      } else {
+        os << c;
+      }
+    }
+    os << '"';
+  }
+
+public:
+  Metrics(int year, int day) : year(year), day(day) {}
+
+  void set_input_bytes(uint64_t bytes) { input_bytes = bytes; }
+
+  PhaseMetrics &add_phase(std::string_view phase, std::string_view variant) {
+    auto &phase_metrics = phases.emplace_back();
+    phase_metrics.phase = phase;
+    phase_metrics.variant = variant;
+    return phase_metrics;
+  }
+
+  double total_wall_seconds() const {
+    double total = 0;
+    for (const auto &p : phases) {
+      total += p.wall_seconds;
+    }
+    return total;
+  }
+
+  std::string to_json() const {
+    std::ostringstream os;
+    os.precision(9);
+    os << "{\"year\":" << year << ",\"day\":" << day
+       << ",\"input_bytes\":" << input_bytes << ",\"phases\":[";
+    for (size_t i = 0; i < phases.size(); ++i) {
+      const auto &p = phases[i];
+      os << (i ? "," : "") << "{\"phase\":";
+      write_string(os, p.phase);
+      os << ",\"variant\":";
+      write_string(os, p.variant);
+      os << ",\"wall_seconds\":" << p.wall_seconds
+         << ",\"cpu_seconds\":" << p.cpu_seconds
+         << ",\"peak_rss_bytes\":" << p.peak_rss_bytes;
+      if (p.median_wall_seconds) {
+        os << ",\"median_wall_seconds\":" << *p.median_wall_seconds
+           << ",\"p95_wall_seconds\":" << *p.p95_wall_seconds;
+      }
+      os << ",\"counts\":{";
+      for (size_t j = 0; j < p.counts.size(); ++j) {
+        os << (j ? "," : "");
+        write_string(os, p.counts[j].first);
+        os << ':' << p.counts[j].second;
+      }
+      os << "}}";
+    }
+    os << "]}";
+    return os.str();
+  }
+
+  // Write the JSON document (plus a newline) to a file descriptor.
+  void write_to(int fd) const {
+    const auto json = to_json() + "\n";
+    for (size_t written = 0; written < json.size();) {
+      const auto n = write(fd, json.data() + written, json.size() - written);
+      if (n <= 0) {
+        std::cerr << "Failed to write metrics to fd " << fd << std::endl;
+        return;
+      }
+      written += n;
+    }
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,525 @@
+#pragma once
+
+#include "common/cache.hpp"
+#include "common/input.hpp"
+#include "common/metrics.hpp"
+#include "common/tasks.hpp"
+#include "common/wide.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Keep the compiler from optimizing away a result we never look at.
+template <typename T> inline void do_not_optimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// e.g. "12.345 ms"
+inline std::string format_seconds(double seconds) {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3);
+  if (seconds < 1e-3) {
+    oss << seconds * 1e6 << " us";
+  } else if (seconds < 1) {
+    oss << seconds * 1e3 << " ms";
+  } else {
+    oss << seconds << " s";
+  }
+  return oss.str();
+}
+
+struct DayId {
+  int year;
+  int day;
+};
+
+// Command line options shared by every day:
+//   ./main.out [--bench] [--warmup=N] [--reps=N] [--metrics-fd=N] [--stream]
+//              [input.txt]
+// Without an input path the input is read from stdin.
+//
+// With --stream, days that can solve everything in one pass over the input
+// lines (see `Runner::stream()`) only do that, reading the input through a
+// fixed-size buffer instead of loading it, e.g.
+//   ./generate.out 100000000 | ./main.out --stream
+//
+// With --metrics-fd=N (or AOC_METRICS_FD=N in the environment), per-phase
+// metrics are written to file descriptor N as one JSON document, e.g.
+//   ./main.out --metrics-fd=3 input.txt 3> metrics.json
+struct Options {
+  const char *input_path = nullptr;
+  // the input itself instead of a path, e.g. as sent to the daemon
+  std::optional<std::string_view> input_text;
+  bool bench = false;
+  bool stream = false;
+  int warmup = 3;
+  int repetitions = 20;
+  int metrics_fd = -1;
+
+  static Options parse(int argc, char **argv) {
+    Options options;
+    if (const auto *fd = std::getenv("AOC_METRICS_FD"); fd && *fd) {
+      options.metrics_fd = to_int<int>(fd);
+    }
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      if (arg == "--bench") {
+        options.bench = true;
+      } else if (arg == "--stream") {
+        options.stream = true;
+      } else if (arg.starts_with("--warmup=")) {
+        options.warmup = to_int<int>(arg.substr(9));
+      } else if (arg.starts_with("--reps=")) {
+        options.repetitions = std::max(1, to_int<int>(arg.substr(7)));
+      } else if (arg.starts_with("--metrics-fd=")) {
+        options.metrics_fd = to_int<int>(arg.substr(13));
+      } else if (arg.starts_with("--")) {
+        throw std::runtime_error("Unknown option: " + std::string(arg));
+      } else {
+        options.input_path = argv[i];
+      }
+    }
+    return options;
+  }
+};
+
+// Drives one day: loads the input, runs the parse phase and every variant of
+// every part, and prints the answers. Variants of the same part (e.g.
+// `part_2_simple` and `part_2_optimized`) must agree, otherwise `finish()`
+// fails.
+//
+// In bench mode, each phase runs `warmup` times untimed and then
+// `repetitions` times timed, and the median/p95/min per phase are reported.
+// Parsing is timed separately from solving.
+//
+// Given a `StateCache` (as in the daemon), the parse result and everything
+// computed with `derive()` are looked up by the input's content first, and
+// only computed on a miss.
+//
+// Every phase also records wall time, CPU time, peak RSS and the item counts
+// reported with `aoc::count()`; see `Options` for how to get them as JSON.
+//
+// Given a `TaskPool` (as in the all-days runner), parsing and every part run
+// as tasks on the pool instead: `part()` only queues the variant, so the
+// lambdas passed to it must stay valid until `finish()`, which waits for them.
+// Output is then buffered, see `output()` and `errors()`.
+class Runner {
+private:
+  using clock = std::chrono::steady_clock;
+
+  struct Answer {
+    int part;
+    std::string variant;
+    std::string value;
+  };
+
+  DayId id;
+  Options options;
+  Metrics metrics;
+  std::shared_ptr<const Input> input_;
+  StateCache *cache;
+  // e.g. "2025/11/<hash of the input>/", for the cache keys
+  std::string cache_prefix;
+  // the parse result and derived states (`CachedState`s), kept alive here
+  std::shared_ptr<const void> parsed;
+  std::vector<std::shared_ptr<const void>> derived;
+  // a deque, so that queued parts can fill in their answer
+  std::deque<Answer> answers;
+  bool mismatch = false;
+  std::optional<TaskGroup> tasks;
+  std::ostringstream buffered_output, buffered_errors;
+  std::ostream *out = &std::cout;
+  std::ostream *err = &std::cerr;
+
+  void report(PhaseMetrics &phase_metrics, std::vector<double> seconds) const {
+    std::sort(seconds.begin(), seconds.end());
+    const auto n = seconds.size();
+    const auto median = (n % 2) ? seconds[n / 2]
+                                : (seconds[n / 2 - 1] + seconds[n / 2]) / 2;
+    const auto p95 = seconds[static_cast<size_t>(std::ceil(0.95 * n)) - 1];
+    phase_metrics.median_wall_seconds = median;
+    phase_metrics.p95_wall_seconds = p95;
+    std::cout << std::left << std::setw(8) << phase_metrics.phase
+              << std::setw(28) << phase_metrics.variant << std::right
+              << std::setw(14) << format_seconds(median) << std::setw(14)
+              << format_seconds(p95) << std::setw(14)
+              << format_seconds(seconds.front()) << std::endl;
+  }
+
+  // CPU time of the whole process, or of the worker thread when other days
+  // run concurrently
+  double cpu_seconds() const {
+    return tasks ? thread_cpu_seconds() : process_cpu_seconds();
+  }
+
+  // Run `f` once and record its metrics.
+  template <typename F> auto run_once(PhaseMetrics &phase_metrics, F &f) {
+    const auto start = clock::now();
+    const auto cpu_start = cpu_seconds();
+    auto result = f();
+    do_not_optimize(result);
+    phase_metrics.cpu_seconds = cpu_seconds() - cpu_start;
+    phase_metrics.wall_seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+    phase_metrics.peak_rss_bytes = peak_rss_bytes();
+    return result;
+  }
+
+  // Run `f` once, or warmup + repetitions times in bench mode. Returns the
+  // result of the last run.
+  template <typename F> auto measure(PhaseMetrics &phase_metrics, F &&f) {
+    detail::current_phase = &phase_metrics;
+    detail::echo_counts = !options.bench && !tasks;
+    if (!options.bench) {
+      return run_once(phase_metrics, f);
+    }
+    for (int i = 0; i < options.warmup; ++i) {
+      do_not_optimize(f());
+    }
+    std::vector<double> seconds;
+    seconds.reserve(options.repetitions);
+    for (int i = 0;; ++i) {
+      auto result = run_once(phase_metrics, f);
+      seconds.push_back(phase_metrics.wall_seconds);
+      if (i + 1 == options.repetitions) {
+        report(phase_metrics, std::move(seconds));
+        return result;
+      }
+    }
+  }
+
+  // Run a phase the parts depend on right away: on this thread, or as a task
+  // that we wait for.
+  template <typename F> auto run_phase(PhaseMetrics &phase_metrics, F &f) {
+    if (!tasks) {
+      return measure(phase_metrics, f);
+    }
+    std::optional<decltype(f())> result;
+    tasks->run([&] { result.emplace(measure(phase_metrics, f)); });
+    tasks->wait();
+    // counts reported right after the phase land in it
+    detail::current_phase = &phase_metrics;
+    return std::move(*result);
+  }
+
+  std::string cache_key(std::string_view phase) {
+    if (cache_prefix.empty()) {
+      const auto text = input().view();
+      cache_prefix = std::to_string(id.year) + "/" + std::to_string(id.day) +
+                     "/" + std::to_string(std::hash<std::string_view>()(text)) +
+                     "/";
+    }
+    return cache_prefix + std::string(phase);
+  }
+
+  // Record that a phase was served from the cache.
+  void cache_hit(PhaseMetrics &phase_metrics) {
+    detail::current_phase = &phase_metrics;
+    count("cache_hit", 1);
+  }
+
+  // Print the answer if it's the first one for its part, otherwise check it
+  // against that one.
+  void check(const Answer &answer) {
+    const auto first = std::find_if(
+        answers.cbegin(), answers.cend(),
+        [&](const auto &other) { return other.part == answer.part; });
+    if (&*first == &answer) {
+      if (!options.bench) {
+        *out << "Part " << answer.part << ": " << answer.value << std::endl;
+      }
+    } else if (first->value != answer.value) {
+      *err << "Part " << answer.part << " implementations do not match: "
+           << first->variant << "=" << first->value << ", " << answer.variant
+           << "=" << answer.value << std::endl;
+      mismatch = true;
+    }
+  }
+
+  template <typename T> static std::string to_string(const T &value) {
+    if constexpr (std::is_same_v<T, uint128>) {
+      return aoc::to_string(value);
+    } else {
+      std::ostringstream oss;
+      oss << value;
+      return oss.str();
+    }
+  }
+
+public:
+  Runner(DayId id, Options options, TaskPool *pool = nullptr,
+         StateCache *cache = nullptr)
+      : id(id), options(options), metrics(id.year, id.day), cache(cache) {
+    detail::current_phase = nullptr;
+    detail::echo_counts = !options.bench && !pool;
+    if (pool) {
+      if (options.bench) {
+        throw std::runtime_error("Can't benchmark days running concurrently");
+      }
+      tasks.emplace(*pool);
+      out = &buffered_output;
+      err = &buffered_errors;
+    }
+    if (options.bench) {
+      std::cout << "--- Benchmark: " << options.warmup << " warm-up, "
+                << options.repetitions << " timed repetitions ---\n"
+                << std::left << std::setw(8) << "phase" << std::setw(28)
+                << "variant" << std::right << std::setw(14) << "median"
+                << std::setw(14) << "p95" << std::setw(14) << "min"
+                << std::endl;
+    }
+  }
+
+  bool benchmarking() const { return options.bench; }
+  bool streaming() const { return options.stream; }
+
+  const Input &input() {
+    if (!input_) {
+      if (options.input_text) {
+        input_ =
+            std::make_shared<const Input>(std::string(*options.input_text));
+      } else if (options.input_path) {
+        input_ = std::make_shared<const Input>(options.input_path);
+      } else {
+        input_ = std::make_shared<const Input>(STDIN_FILENO);
+      }
+      metrics.set_input_bytes(input_->view().size());
+    }
+    return *input_;
+  }
+
+  // `parse_fn` turns the raw input text into whatever the parts work on. The
+  // result stays valid for the lifetime of the runner.
+  template <typename F> const auto &parse(F &&parse_fn) {
+    using State = CachedState<std::invoke_result_t<F &, std::string_view>>;
+    const auto text = input().view();
+    auto &phase_metrics = metrics.add_phase("parse", "");
+    if (cache) {
+      const auto state = cache->find<State>(cache_key("parse"));
+      // the key is only a hash, so make sure it's the same input
+      if (state &&
+          static_cast<const Input *>(state->source.get())->view() == text) {
+        cache_hit(phase_metrics);
+        parsed = state;
+        return state->value;
+      }
+    }
+    auto parse_text = [&] { return parse_fn(text); };
+    // the result may point into the input, so it keeps the input alive
+    auto state = std::make_shared<const State>(
+        State{input_, run_phase(phase_metrics, parse_text)});
+    if (cache) {
+      cache->insert(cache_key("parse"), state);
+    }
+    parsed = state;
+    return state->value;
+  }
+
+  // Compute state that several parts share from the parse result (e.g. a
+  // topological order), as a phase of its own named `name`. With a cache, it
+  // is reused along with the parse result it was derived from.
+  template <typename F>
+  const auto &derive(std::string_view name, F &&compute) {
+    using State = CachedState<std::invoke_result_t<F &>>;
+    auto &phase_metrics = metrics.add_phase("derive", name);
+    const auto key = cache ? cache_key("derive/" + std::string(name)) : "";
+    if (cache) {
+      const auto state = cache->find<State>(key);
+      if (state && state->source == parsed) {
+        cache_hit(phase_metrics);
+        derived.push_back(state);
+        return state->value;
+      }
+    }
+    auto state = std::make_shared<const State>(
+        State{parsed, run_phase(phase_metrics, compute)});
+    if (cache) {
+      cache->insert(key, state);
+    }
+    derived.push_back(state);
+    return state->value;
+  }
+
+  // Run one variant of a part. The first variant's answer is printed, later
+  // ones are checked against it.
+  template <typename F>
+  void part(int part, std::string_view variant, F &&solve) {
+    auto &phase_metrics =
+        metrics.add_phase("part " + std::to_string(part), variant);
+    auto &answer = answers.emplace_back(Answer{part, std::string(variant), ""});
+    if (!tasks) {
+      answer.value = to_string(measure(phase_metrics, solve));
+      check(answer);
+      return;
+    }
+    tasks->run([this, &phase_metrics, &answer,
+                solve = std::forward<F>(solve)]() mutable {
+      answer.value = to_string(measure(phase_metrics, solve));
+    });
+  }
+
+  // Solve the parts in a single pass over the input lines, for days whose
+  // records are independent. `solve(aoc::LineReader &)` returns the answer to
+  // part 1, or a pair (or tuple) with the answers to every part, which are
+  // checked against the other variants as usual.
+  //
+  // With --stream the input isn't loaded, and each run reads it afresh from
+  // the file (or once from stdin) in constant memory; otherwise the lines come
+  // from the loaded input.
+  template <typename F> void stream(std::string_view variant, F &&solve) {
+    using Result = std::invoke_result_t<F &, LineReader &>;
+    auto &phase_metrics = metrics.add_phase("stream", variant);
+    if (options.stream && !options.input_path && options.bench) {
+      throw std::runtime_error("Benchmarking a stream needs an input path");
+    }
+    if (!options.stream) {
+      input(); // load it here, not on some worker thread
+    }
+    auto read_and_solve = [this, solve = std::forward<F>(solve)]() mutable {
+      if (!options.stream) {
+        LineReader lines{input().view()};
+        return solve(lines);
+      }
+      std::optional<LineReader> lines;
+      if (options.input_path) {
+        lines.emplace(options.input_path);
+      } else {
+        lines.emplace(STDIN_FILENO);
+      }
+      auto result = solve(*lines);
+      metrics.set_input_bytes(lines->bytes_read());
+      return result;
+    };
+    // one answer per part, filled in once solved
+    std::vector<Answer *> parts;
+    const auto add_answer = [&](int part) {
+      parts.push_back(
+          &answers.emplace_back(Answer{part, std::string(variant), ""}));
+    };
+    if constexpr (requires { std::tuple_size<Result>::value; }) {
+      for (size_t i = 0; i < std::tuple_size_v<Result>; ++i) {
+        add_answer(i + 1);
+      }
+    } else {
+      add_answer(1);
+    }
+    auto solve_all = [this, &phase_metrics, parts,
+                      read_and_solve = std::move(read_and_solve)]() mutable {
+      const auto result = measure(phase_metrics, read_and_solve);
+      if constexpr (requires { std::tuple_size<Result>::value; }) {
+        std::apply(
+            [&](const auto &...values) {
+              size_t i = 0;
+              ((parts[i++]->value = to_string(values)), ...);
+            },
+            result);
+      } else {
+        parts[0]->value = to_string(result);
+      }
+    };
+    if (!tasks) {
+      solve_all();
+      for (const auto *answer : parts) {
+        check(*answer);
+      }
+      return;
+    }
+    tasks->run(std::move(solve_all));
+  }
+
+  // Returns the exit code for main().
+  int finish() {
+    if (tasks) {
+      tasks->wait();
+      for (const auto &answer : answers) {
+        check(answer);
+      }
+    }
+    detail::current_phase = nullptr;
+    if (options.metrics_fd >= 0) {
+      write_metrics(options.metrics_fd);
+    }
+    if (options.bench) {
+      for (const auto &answer : answers) {
+        *out << "Part " << answer.part << " (" << answer.variant
+             << "): " << answer.value << std::endl;
+      }
+    }
+    return mismatch ? 1 : 0;
+  }
+
+  void write_metrics(int fd) const { metrics.write_to(fd); }
+
+  // total wall time of all phases run so far
+  double busy_seconds() const { return metrics.total_wall_seconds(); }
+
+  // what would have gone to stdout/stderr when running with a `TaskPool`
+  std::string output() const { return buffered_output.str(); }
+  std::string errors() const { return buffered_errors.str(); }
+};
+
+// Entry point for a day: `int main(int argc, char **argv) { return
+// aoc::run(argc, argv, {2025, 1}, run_day); }`, where `run_day(aoc::Runner &)`
+// returns the exit code, usually `runner.finish()`.
+template <typename Day>
+int run(int argc, char **argv, DayId id, Day &&run_day) {
+  try {
+    Runner runner{id, Options::parse(argc, argv)};
+    return run_day(runner);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
+
+// A day linked into the all-days runner, see common/all_days.cpp.
+struct RegisteredDay {
+  DayId id;
+  std::function<int(Runner &)> run_day;
+};
+
+inline std::vector<RegisteredDay> &registered_days() {
+  static std::vector<RegisteredDay> days;
+  return days;
+}
+
+inline bool register_day(DayId id, std::function<int(Runner &)> run_day) {
+  registered_days().push_back(RegisteredDay{id, std::move(run_day)});
+  return true;
+}
+
+} // namespace aoc
+
+// Defines main() for a day, i.e. `aoc::run()` with the given `run_day`. When
+// built with -DAOC_ALL_DAYS, the day is registered with the all-days runner
+// instead, so that every day can be linked into a single executable. Each
+// day keeps the rest of its code in an anonymous namespace for the same
+// reason.
+#ifdef AOC_ALL_DAYS
+#define AOC_MAIN(year, day, run_day)                                           \
+  [[maybe_unused]] static const bool aoc_registered =                          \
+      aoc::register_day({year, day}, run_day);
+#else
+#define AOC_MAIN(year, day, run_day)                                           \
+  int main(int argc, char **argv) {                                            \
+    return aoc::run(argc, argv, {year, day}, run_day);                         \
+  }
+#endif
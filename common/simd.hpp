@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// GCC's and Clang's vector extensions: arithmetic, comparisons and shifts
+// apply lane-wise, and GCC maps each vector onto whatever registers the
+// target has (one AVX2 register for 32 bytes).
+//
+// Passing these by value makes GCC note that their ABI differs with and
+// without AVX. They never cross a translation unit boundary here, so that
+// note is silenced for every file that includes this one.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace aoc {
+
+using u8x8 = uint8_t __attribute__((vector_size(8)));
+using i8x8 = int8_t __attribute__((vector_size(8)));
+using u8x32 = uint8_t __attribute__((vector_size(32)));
+using u32x8 = uint32_t __attribute__((vector_size(32)));
+using u64x4 = uint64_t __attribute__((vector_size(32)));
+using u64x8 = uint64_t __attribute__((vector_size(64)));
+using i64x8 = int64_t __attribute__((vector_size(64)));
+
+} // namespace aoc
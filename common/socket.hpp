@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace aoc {
+
+// Where the daemon listens unless told otherwise: $AOC_SOCKET, or aoc.sock in
+// $XDG_RUNTIME_DIR, or /tmp/aoc-<uid>.sock.
+inline std::string default_socket_path() {
+  if (const auto *path = std::getenv("AOC_SOCKET"); path && *path) {
+    return path;
+  }
+  if (const auto *dir = std::getenv("XDG_RUNTIME_DIR"); dir && *dir) {
+    return std::string(dir) + "/aoc.sock";
+  }
+  return "/tmp/aoc-" + std::to_string(getuid()) + ".sock";
+}
+
+namespace detail {
+inline sockaddr_un socket_address(const std::string &path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Socket path too long: " + path);
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return address;
+}
+
+inline int unix_socket() {
+  const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Failed to create a socket");
+  }
+  return fd;
+}
+} // namespace detail
+
+// Listen on a Unix domain socket at `path`, replacing a stale socket file
+// left behind by a previous daemon. Returns the listening file descriptor.
+inline int listen_on(const std::string &path) {
+  const auto address = detail::socket_address(path);
+  const int fd = detail::unix_socket();
+  unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<const sockaddr *>(&address),
+           sizeof(address)) < 0 ||
+      listen(fd, SOMAXCONN) < 0) {
+    const auto error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(),
+                            "Failed to listen on " + path);
+  }
+  return fd;
+}
+
+// One end of a connected Unix domain stream socket, with buffered reads of
+// lines and fixed-size payloads. Closes the socket when destroyed.
+class Connection {
+private:
+  int fd;
+  std::string buffer; // read but not consumed yet
+
+  // Read more into the buffer; false at the end of the stream.
+  bool fill() {
+    char chunk[1 << 16];
+    for (;;) {
+      const auto n = read(fd, chunk, sizeof(chunk));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to read from socket");
+      }
+      buffer.append(chunk, n);
+      return n > 0;
+    }
+  }
+
+public:
+  explicit Connection(int fd) : fd(fd) {}
+  Connection(const Connection &) = delete;
+  Connection &operator=(const Connection &) = delete;
+  ~Connection() {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  static Connection connect_to(const std::string &path) {
+    const auto address = detail::socket_address(path);
+    Connection connection{detail::unix_socket()};
+    if (connect(connection.fd, reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Failed to connect to " + path +
+                                  " (is the daemon running?)");
+    }
+    return connection;
+  }
+
+  Connection(Connection &&other) noexcept
+      : fd(std::exchange(other.fd, -1)), buffer(std::move(other.buffer)) {}
+  Connection &operator=(Connection &&) = delete;
+
+  void write_all(std::string_view data) {
+    while (!data.empty()) {
+      // a peer that went away must not kill us with SIGPIPE
+      const auto n = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to write to socket");
+      }
+      data.remove_prefix(n);
+    }
+  }
+
+  // The next line, without its '\n'.
+  std::string read_line() {
+    size_t end;
+    while ((end = buffer.find('\n')) == std::string::npos) {
+      if (!fill()) {
+        throw std::runtime_error("Connection closed in the middle of a line");
+      }
+    }
+    auto line = buffer.substr(0, end);
+    buffer.erase(0, end + 1);
+    return line;
+  }
+
+  // Exactly the next n bytes.
+  std::string read_exact(size_t n) {
+    while (buffer.size() < n) {
+      if (!fill()) {
+        throw std::runtime_error("Connection closed before the payload ended");
+      }
+    }
+    auto data = buffer.substr(0, n);
+    buffer.erase(0, n);
+    return data;
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// A fixed set of worker threads running jobs in the order they were queued.
+// Jobs must not block waiting for other jobs of the same pool.
+class TaskPool {
+private:
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<std::function<void()>> jobs;
+  bool stopping = false;
+  std::vector<std::jthread> workers;
+
+  void work() {
+    for (;;) {
+      std::function<void()> job;
+      {
+        std::unique_lock lock{mutex};
+        wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+          return;
+        }
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+public:
+  // 0 threads means one per hardware thread
+  explicit TaskPool(unsigned threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  // finishes the queued jobs, then joins the workers
+  ~TaskPool() {
+    {
+      std::lock_guard lock{mutex};
+      stopping = true;
+    }
+    wake.notify_all();
+  }
+
+  size_t size() const { return workers.size(); }
+
+  void submit(std::function<void()> job) {
+    {
+      std::lock_guard lock{mutex};
+      jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+  }
+};
+
+// Jobs submitted to a pool that can be waited for together, e.g. all parts
+// of one day. The first exception thrown by a job is rethrown by `wait()`.
+class TaskGroup {
+private:
+  TaskPool &pool;
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t pending = 0;
+  std::exception_ptr error;
+
+public:
+  explicit TaskGroup(TaskPool &pool) : pool(pool) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  // jobs may still refer to the caller's locals, so never leave them behind
+  ~TaskGroup() {
+    std::unique_lock lock{mutex};
+    finished.wait(lock, [&] { return pending == 0; });
+  }
+
+  void run(std::function<void()> job) {
+    {
+      std::lock_guard lock{mutex};
+      ++pending;
+    }
+    pool.submit([this, job = std::move(job)] {
+      std::exception_ptr job_error;
+      try {
+        job();
+      } catch (...) {
+        job_error = std::current_exception();
+      }
+      std::lock_guard lock{mutex};
+      if (job_error && !error) {
+        error = job_error;
+      }
+      if (--pending == 0) {
+        finished.notify_all();
+      }
+    });
+  }
+
+  void wait() {
+    std::unique_lock lock{mutex};
+    finished.wait(lock, [&] { return pending == 0; });
+    if (error) {
+      std::rethrow_exception(std::exchange(error, nullptr));
+    }
+  }
+};
+
+// Split [0, n) into contiguous chunks, one per hardware thread but none
+// smaller than `min_chunk`, and run `f(begin, end)` on all of them
+// concurrently, the first on the calling thread. The results come back in
+// chunk order, so that reducing them is deterministic. `f` must not throw.
+template <typename F> auto map_chunks(size_t n, size_t min_chunk, F &&f) {
+  using Result = std::invoke_result_t<F &, size_t, size_t>;
+  const size_t max_chunks = std::max(1u, std::thread::hardware_concurrency());
+  const auto chunks =
+      std::clamp<size_t>(n / std::max<size_t>(min_chunk, 1), 1, max_chunks);
+  const auto bound = [&](size_t chunk) { return n * chunk / chunks; };
+  std::vector<Result> results(chunks);
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(chunks - 1);
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+      threads.emplace_back([&, chunk] {
+        results[chunk] = f(bound(chunk), bound(chunk + 1));
+      });
+    }
+    results[0] = f(0, bound(1));
+  }
+  return results;
+}
+
+} // namespace aoc
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+// GCC's and Clang's 128-bit integers, for answers that don't fit in 64 bits.
+// ISO C++ has no such type, hence `__extension__` to keep -pedantic quiet.
+// Neither `std::from_chars` nor streams handle them, so parsing and
+// formatting are below (and `Runner` prints them as answers).
+__extension__ using uint128 = unsigned __int128;
+
+// Parse a whole field of decimal digits, e.g. "123" -> 123. Anything else,
+// or a value that doesn't fit, is an error, like `to_int()`.
+inline uint128 to_uint128(std::string_view field) {
+  constexpr auto max = ~uint128{0};
+  uint128 value = 0;
+  for (const char c : field) {
+    if (c < '0' || c > '9' || value > (max - (c - '0')) / 10) {
+      throw std::runtime_error("Invalid integer: '" + std::string(field) +
+                               "'");
+    }
+    value = value * 10 + (c - '0');
+  }
+  if (field.empty()) {
+    throw std::runtime_error("Invalid integer: ''");
+  }
+  return value;
+}
+
+inline std::string to_string(uint128 value) {
+  std::string digits;
+  do {
+    digits.push_back('0' + static_cast<char>(value % 10));
+    value /= 10;
+  } while (value > 0);
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
+
+} // namespace aoc